@@ -0,0 +1,28 @@
+# SPDX-License-Identifier: Apache-2.0
+#
+# Button module sources, shared by the application and the test suites.
+
+zephyr_include_directories(${CMAKE_CURRENT_LIST_DIR}/include)
+
+target_sources(app PRIVATE
+	       ${CMAKE_CURRENT_LIST_DIR}/src/button.c
+	       ${CMAKE_CURRENT_LIST_DIR}/src/button_cfg.c)
+target_sources_ifdef(CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME app PRIVATE
+		     ${CMAKE_CURRENT_LIST_DIR}/src/button_time.c)
+target_sources_ifdef(CONFIG_BUTTON_BACKEND_GPIO app PRIVATE
+		     ${CMAKE_CURRENT_LIST_DIR}/src/button_gpio.c
+		     ${CMAKE_CURRENT_LIST_DIR}/src/button_debounce.c)
+target_sources_ifdef(CONFIG_BUTTON_BACKEND_INPUT app PRIVATE
+		     ${CMAKE_CURRENT_LIST_DIR}/src/button_input.c)
+target_sources_ifdef(CONFIG_BUTTON_BACKEND_ADC app PRIVATE
+		     ${CMAKE_CURRENT_LIST_DIR}/src/button_adc.c)
+if(CONFIG_BUTTON_OBS_STATS)
+  target_sources(app PRIVATE ${CMAKE_CURRENT_LIST_DIR}/src/button_obs.c)
+  zephyr_linker_sources(DATA_SECTIONS ${CMAKE_CURRENT_LIST_DIR}/src/button_obs.ld)
+endif()
+target_sources_ifdef(CONFIG_ENCODER app PRIVATE ${CMAKE_CURRENT_LIST_DIR}/src/encoder.c)
+target_sources_ifdef(CONFIG_LED_BCM app PRIVATE ${CMAKE_CURRENT_LIST_DIR}/src/led_bcm.c)
+target_sources_ifdef(CONFIG_BUTTON_KEYMAP app PRIVATE
+		     ${CMAKE_CURRENT_LIST_DIR}/src/button_keymap.c)
+target_sources_ifdef(CONFIG_BUTTON_PERSIST app PRIVATE
+		     ${CMAKE_CURRENT_LIST_DIR}/src/button_persist.c)
@@ -1,21 +1,154 @@
 #ifndef _BUTTON_H_
 #define _BUTTON_H_
+#include <stdbool.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/sys/util.h>
 #include <zephyr/zbus/zbus.h>
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Buttons are the children of the node holding the sw0 alias, indexed in devicetree order. The
+ * node is gpio-keys for the GPIO and input backends, and adc-keys for the ADC backend.
+ */
+#define BUTTON_NODE_LIST DT_PARENT(DT_ALIAS(sw0))
+#define BUTTON_COUNT     DT_CHILD_NUM_STATUS_OKAY(BUTTON_NODE_LIST)
+
+/* Debounce time before any button_cfg_set(): the node's debounce-interval-ms when it has one. */
+#define BUTTON_DEBOUNCE_MS_DEFAULT                                                                 \
+	DT_PROP_OR(BUTTON_NODE_LIST, debounce_interval_ms, CONFIG_BUTTON_DEBOUNCE_MS)
+
 enum button_evt_type {
 	BUTTON_EVT_UNDEFINED,
 	BUTTON_EVT_PRESSED,
 	BUTTON_EVT_RELEASED,
 	BUTTON_EVT_LONGPRESS,
+	BUTTON_EVT_REPEAT,
+	BUTTON_EVT_HOLD,
 };
 
+/* Number of event types, for tables indexed by enum button_evt_type. */
+#define BUTTON_EVT_TYPE_COUNT (BUTTON_EVT_HOLD + 1)
+
+/* Hold thresholds per button, see struct button_cfg. */
+#define BUTTON_HOLD_LEVELS 3
+
+/* The event reports the level sampled at init rather than a transition. */
+#define BUTTON_EVT_FLAG_INITIAL   BIT(0)
+/* The transition's edge was lost and found later by CONFIG_BUTTON_RECONCILE_MS. */
+#define BUTTON_EVT_FLAG_RECOVERED BIT(1)
+
 struct msg_button_evt {
 	enum button_evt_type evt;
+	/* Index of the button within BUTTON_NODE_LIST. */
+	uint8_t button;
+	/* BUTTON_EVT_FLAG_* */
+	uint8_t flags;
+	/* Threshold reached by BUTTON_EVT_HOLD, 1..BUTTON_HOLD_LEVELS. */
+	uint8_t hold_level;
+	/* k_cycle_get_32() when the debounced transition was observed. */
+	uint32_t timestamp;
+	/* How long the press lasted, for RELEASED, LONGPRESS and HOLD. */
+	uint32_t held_ms;
+};
+
+enum button_debounce_mode {
+	BUTTON_DEBOUNCE_MODE_SOFTWARE,
+	/* Filtered by the GPIO controller, see CONFIG_BUTTON_HW_DEBOUNCE. */
+	BUTTON_DEBOUNCE_MODE_HARDWARE,
+	/* Not debounced at all: its button-debounce entry selects "none". */
+	BUTTON_DEBOUNCE_MODE_NONE,
+};
+
+/* Event counters of one button since boot. */
+struct button_stats {
+	uint32_t presses;
+	uint32_t releases;
+	uint32_t long_presses;
+	/* Transitions published with BUTTON_EVT_FLAG_RECOVERED. */
+	uint32_t recovered;
+	/* Where the button is debounced, decided by button_init(). */
+	enum button_debounce_mode debounce_mode;
+};
+
+/*
+ * Runtime parameters of one button. A press uses the parameters that were current when it
+ * started, so changing them mid-press only affects the next press.
+ */
+struct button_cfg {
+	/* Settle time of the software debounce. Ignored by the input backend. */
+	uint16_t debounce_ms;
+	/* Minimum hold time for BUTTON_EVT_LONGPRESS after the release. */
+	uint16_t long_press_ms;
+	/* Hold time before the first BUTTON_EVT_REPEAT, 0 disables repeat. */
+	uint16_t repeat_delay_ms;
+	/* Period of the following BUTTON_EVT_REPEAT events. */
+	uint16_t repeat_interval_ms;
+	/*
+	 * Hold times publishing BUTTON_EVT_HOLD with levels 1, 2, ... while the button stays held.
+	 * Increasing; the first 0 disables that level and the ones after it.
+	 */
+	uint16_t hold_ms[BUTTON_HOLD_LEVELS];
+};
+
+/* Applies a configuration to every button when used as msg_button_cfg.button. */
+#define BUTTON_CFG_ALL 0xff
+
+struct msg_button_cfg {
+	uint8_t button;
+	struct button_cfg cfg;
 };
 
+/*
+ * Button events, published one at a time from the button work queue (the system work queue
+ * without CONFIG_BUTTON_WORKQ). Listeners run there, so a slow one delays the following events
+ * and the debounce work, but never interrupts.
+ */
 ZBUS_CHAN_DECLARE(chan_button_evt);
+/* Publishing here reconfigures buttons; invalid messages are rejected by the validator. */
+ZBUS_CHAN_DECLARE(chan_button_cfg);
 
+/*
+ * Both are idempotent. With CONFIG_BUTTON_AUTO_INIT they already ran before main(), and
+ * init published one BUTTON_EVT_FLAG_INITIAL event per button with its sampled level.
+ * button_init() returns -EBUSY while another caller is still initialising.
+ */
 int button_init(void);
 int button_enable_interrupts(void);
 
+/* Buttons held when the module initialised, bit n for button n. For recovery key combos. */
+uint32_t button_boot_mask(void);
+
+/* True when exactly the buttons in combo were held at boot. */
+static inline bool button_boot_combo(uint32_t combo)
+{
+	return button_boot_mask() == combo;
+}
+
+/* k_cycle_get_32() when init finished and events could be published, i.e. time since reset. */
+uint32_t button_ready_cycles(void);
+
+int button_stats_get(uint8_t idx, struct button_stats *stats);
+
+/*
+ * Debounced state as last reported on chan_button_evt, without touching the hardware. Lock-free
+ * and safe from any context including ISRs; button_pressed_mask() is one consistent view of all
+ * buttons. Out of range indices read as released.
+ */
+bool button_is_pressed(uint8_t idx);
+uint32_t button_pressed_mask(void);
+/* Time since the current press started in ms, 0 when released. */
+uint32_t button_held_for(uint8_t idx);
+
+/* Lock-free; safe from any context including ISRs. */
+int button_cfg_get(uint8_t idx, struct button_cfg *cfg);
+/* idx may be BUTTON_CFG_ALL. Never blocks the event path. */
+int button_cfg_set(uint8_t idx, const struct button_cfg *cfg);
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif /* _BUTTON_H_ */
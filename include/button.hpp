@@ -0,0 +1,180 @@
+#ifndef _BUTTON_HPP_
+#define _BUTTON_HPP_
+/*
+ * Header-only C++17 layer over button.h and the GPIO LED API.
+ *
+ * Everything is static and resolved at compile time: Button and Led are parameterised on a
+ * devicetree node through BUTTON_DT() and LED_DT(), a Listener dispatches chan_button_evt to
+ * handlers chosen by template arguments with fold expressions, and nothing uses virtual calls or
+ * the heap. Each member compiles down to the C call it wraps.
+ *
+ * A Button may also carry a constexpr button_cfg through BUTTON_DT_CFG(). The configuration is
+ * checked with static_assert, so a bad one fails the build instead of button_cfg_set(), and
+ * init() applies it.
+ *
+ *   static constexpr button_cfg front_cfg = {30, 1000, 0, 100, {500, 1500, 0}};
+ *
+ *   using Front = BUTTON_DT_CFG(DT_ALIAS(sw0), front_cfg);
+ *   using Status = LED_DT(DT_ALIAS(led0));
+ *
+ *   void on_front(const msg_button_evt &) { Status::toggle(); }
+ *
+ *   BUTTON_CPP_LISTENER_DEFINE(ui_lis, 3,
+ *                              button::Listener<Front::On<BUTTON_EVT_PRESSED, on_front>>);
+ */
+
+#include <errno.h>
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/zbus/zbus.h>
+
+#include "button.h"
+
+namespace button
+{
+
+/* A handler for one (button, event) pair. Fn is any function taking the event message. */
+template <uint8_t Idx, button_evt_type Evt, auto Fn> struct On {
+	static void handle(const msg_button_evt &msg)
+	{
+		if (msg.button == Idx && msg.evt == Evt) {
+			Fn(msg);
+		}
+	}
+};
+
+/* Runs every handler in Handlers on each event; see BUTTON_CPP_LISTENER_DEFINE(). */
+template <typename... Handlers> struct Listener {
+	static void dispatch(const msg_button_evt &msg)
+	{
+		(Handlers::handle(msg), ...);
+	}
+
+	static void callback(const struct zbus_channel *chan)
+	{
+		dispatch(*static_cast<const msg_button_evt *>(zbus_chan_const_msg(chan)));
+	}
+};
+
+/* Hold thresholds increase up to the first 0, as button_cfg_set() requires. */
+constexpr bool holds_increasing(const button_cfg &cfg)
+{
+	for (int i = 1; i < BUTTON_HOLD_LEVELS; i++) {
+		if (cfg.hold_ms[i] != 0 && cfg.hold_ms[i] <= cfg.hold_ms[i - 1]) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/* The checks of button_cfg_set(), at compile time. */
+constexpr bool cfg_valid(const button_cfg &cfg)
+{
+	return cfg.debounce_ms > 0 && (cfg.repeat_delay_ms == 0 || cfg.repeat_interval_ms > 0) &&
+	       holds_increasing(cfg);
+}
+
+/* Cfg, when given, is the button's configuration, validated here and applied by init(). */
+template <uint8_t Idx, const button_cfg *Cfg = nullptr> class Button
+{
+	static_assert(Idx < BUTTON_COUNT, "not a child of the buttons node");
+	static_assert(Cfg == nullptr || Cfg->debounce_ms > 0, "debounce_ms must not be 0");
+	static_assert(Cfg == nullptr || Cfg->repeat_delay_ms == 0 || Cfg->repeat_interval_ms > 0,
+		      "repeat needs a repeat_interval_ms");
+	static_assert(Cfg == nullptr || holds_increasing(*Cfg),
+		      "hold_ms must increase up to the first 0");
+
+public:
+	static constexpr uint8_t index = Idx;
+
+	/* Applies Cfg; nothing to do without one. */
+	static int init()
+	{
+		if constexpr (Cfg != nullptr) {
+			return button_cfg_set(Idx, Cfg);
+		}
+		return 0;
+	}
+
+	template <button_evt_type Evt, auto Fn> using On = button::On<Idx, Evt, Fn>;
+
+	static int config(const button_cfg &cfg)
+	{
+		return button_cfg_set(Idx, &cfg);
+	}
+
+	static button_cfg config()
+	{
+		button_cfg cfg{};
+
+		(void)button_cfg_get(Idx, &cfg);
+		return cfg;
+	}
+
+	static button_stats stats()
+	{
+		button_stats stats{};
+
+		(void)button_stats_get(Idx, &stats);
+		return stats;
+	}
+};
+
+template <const struct device *Port, gpio_pin_t Pin, gpio_dt_flags_t Flags> class Led
+{
+public:
+	static constexpr gpio_dt_spec spec{Port, Pin, Flags};
+
+	static int init()
+	{
+		if (!gpio_is_ready_dt(&spec)) {
+			return -ENODEV;
+		}
+		return gpio_pin_configure_dt(&spec, GPIO_OUTPUT_INACTIVE);
+	}
+
+	static int set(bool on)
+	{
+		return gpio_pin_set_dt(&spec, on);
+	}
+
+	static int on()
+	{
+		return set(true);
+	}
+
+	static int off()
+	{
+		return set(false);
+	}
+
+	static int toggle()
+	{
+		return gpio_pin_toggle_dt(&spec);
+	}
+};
+
+} /* namespace button */
+
+/* Button type for a child node of the buttons node. */
+#define BUTTON_DT(node_id) ::button::Button<DT_NODE_CHILD_IDX(node_id)>
+
+/* The same with cfg, a constexpr button_cfg with static storage, applied by init(). */
+#define BUTTON_DT_CFG(node_id, cfg) ::button::Button<DT_NODE_CHILD_IDX(node_id), &(cfg)>
+
+/* Led type for a node with a gpios property, e.g. a gpio-leds child. */
+#define LED_DT(node_id)                                                                            \
+	::button::Led<DEVICE_DT_GET(DT_GPIO_CTLR(node_id, gpios)), DT_GPIO_PIN(node_id, gpios),    \
+		      DT_GPIO_FLAGS(node_id, gpios)>
+
+/*
+ * zbus listener on chan_button_evt running a button::Listener<...>, added with priority _prio as
+ * in ZBUS_CHAN_ADD_OBS().
+ */
+#define BUTTON_CPP_LISTENER_DEFINE(_name, _prio, ...)                                              \
+	ZBUS_LISTENER_DEFINE(_name, __VA_ARGS__::callback);                                        \
+	ZBUS_CHAN_ADD_OBS(chan_button_evt, _name, _prio)
+
+#endif /* _BUTTON_HPP_ */
@@ -0,0 +1,54 @@
+#ifndef _BUTTON_KEYMAP_H_
+#define _BUTTON_KEYMAP_H_
+#include <stdint.h>
+#include <zephyr/zbus/zbus.h>
+
+#include "button.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * The button-keymap devicetree node is compiled into a dense [button][event] table, so each
+ * chan_button_evt event is translated with one indexed load. Mapped events are republished on
+ * chan_button_action; events without an entry and BUTTON_EVT_FLAG_INITIAL level reports are not.
+ *
+ * Child nodes of the keymap add layers, switched by BUTTON_LAYER_MO()/BUTTON_LAYER_TG() actions.
+ * Layer 0 is always active and the active set is a bitmask: an event resolves in the highest
+ * active layer that maps it, so lookup is one load in the usual case and one per active layer at
+ * worst. Every event of a press resolves with the layers active when it was pressed, so releasing
+ * a layer key before a key pressed on that layer still delivers that key's RELEASED/LONGPRESS
+ * actions from the same layer.
+ */
+
+/* Action ID of unmapped events, never published. */
+#define BUTTON_ACTION_NONE 0
+
+struct msg_button_action {
+	uint16_t action;
+	/* The event the action was mapped from. */
+	uint8_t button;
+	uint8_t evt;
+	uint32_t timestamp;
+};
+
+ZBUS_CHAN_DECLARE(chan_button_action);
+
+/* Highest action ID for applications; the IDs above are layer switching actions. */
+#define BUTTON_ACTION_MAX 0xfdff
+
+/*
+ * Resolved against the layers active now. BUTTON_ACTION_NONE for unmapped or out of range
+ * events, and layer switching actions are returned as they are.
+ */
+uint16_t button_keymap_lookup(uint8_t button, enum button_evt_type evt);
+
+/* Active layers, bit n for layer n. Bit 0 is always set. */
+uint32_t button_keymap_layers(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _BUTTON_KEYMAP_H_ */
@@ -0,0 +1,82 @@
+#ifndef _BUTTON_OBS_H_
+#define _BUTTON_OBS_H_
+#include <stdint.h>
+#include <zephyr/sys/iterable_sections.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/zbus/zbus.h>
+
+/*
+ * Execution time accounting for listeners of chan_button_evt. Listeners run synchronously inside
+ * zbus_chan_pub(), so a slow one delays every observer after it and the button pipeline itself.
+ *
+ * Define listeners with BUTTON_LISTENER_DEFINE() instead of ZBUS_LISTENER_DEFINE() to have their
+ * callback timed. A call longer than CONFIG_BUTTON_OBS_BUDGET_US is logged and its statistics
+ * are published on chan_button_obs_stats. Without CONFIG_BUTTON_OBS_STATS the macro is a plain
+ * ZBUS_LISTENER_DEFINE().
+ *
+ * zbus cannot time an observer it did not define, so every event the button core publishes is
+ * also timed as a whole under the name "chan_button_evt", against CONFIG_BUTTON_OBS_CHAN_BUDGET_US.
+ * That entry catches slow listeners defined with plain ZBUS_LISTENER_DEFINE(), without naming
+ * them. Events published on the channel by other code are not timed.
+ */
+
+struct button_obs_stats {
+	const char *name;
+	uint32_t calls;
+	uint32_t max_cycles;
+	uint32_t avg_cycles;
+	uint32_t last_cycles;
+	uint32_t over_budget;
+};
+
+ZBUS_CHAN_DECLARE(chan_button_obs_stats);
+
+/* Internal: one per timed listener, collected in an iterable section. */
+struct button_obs_timing {
+	const char *name;
+	void (*cb)(const struct zbus_channel *chan);
+	uint32_t calls;
+	uint32_t max_cycles;
+	uint64_t total_cycles;
+	uint32_t over_budget;
+};
+
+void button_obs_run(struct button_obs_timing *timing, const struct zbus_channel *chan);
+
+/* Internal: how the button core publishes on chan_button_evt. */
+#ifdef CONFIG_BUTTON_OBS_STATS
+int button_obs_evt_pub(const void *msg, k_timeout_t timeout);
+#else
+ZBUS_CHAN_DECLARE(chan_button_evt);
+
+static inline int button_obs_evt_pub(const void *msg, k_timeout_t timeout)
+{
+	return zbus_chan_pub(&chan_button_evt, msg, timeout);
+}
+#endif
+
+#ifdef CONFIG_BUTTON_OBS_STATS
+#define BUTTON_LISTENER_DEFINE(_name, _cb)                                                         \
+	STRUCT_SECTION_ITERABLE(button_obs_timing, _CONCAT(_name, _timing)) = {                    \
+		.name = #_name,                                                                    \
+		.cb = _cb,                                                                         \
+	};                                                                                         \
+	static void _CONCAT(_name, _timed_cb)(const struct zbus_channel *chan)                     \
+	{                                                                                          \
+		button_obs_run(&_CONCAT(_name, _timing), chan);                                    \
+	}                                                                                          \
+	ZBUS_LISTENER_DEFINE(_name, _CONCAT(_name, _timed_cb))
+#else
+#define BUTTON_LISTENER_DEFINE(_name, _cb) ZBUS_LISTENER_DEFINE(_name, _cb)
+#endif
+
+/* Snapshot of a timed listener's statistics by listener name. */
+int button_obs_stats_get(const char *name, struct button_obs_stats *stats);
+
+typedef void (*button_obs_stats_cb_t)(const struct button_obs_stats *stats, void *user_data);
+
+void button_obs_stats_foreach(button_obs_stats_cb_t cb, void *user_data);
+
+void button_obs_stats_reset(void);
+
+#endif /* _BUTTON_OBS_H_ */
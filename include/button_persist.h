@@ -0,0 +1,40 @@
+#ifndef _BUTTON_PERSIST_H_
+#define _BUTTON_PERSIST_H_
+#include <stdint.h>
+#include <zephyr/toolchain.h>
+
+#include "button.h"
+
+/* Lifetime counters of one button, including presses not yet flushed. */
+struct button_persist_counters {
+	uint32_t presses;
+	uint32_t long_presses;
+};
+
+/* One event log entry, as stored in flash. Only PRESSED and LONGPRESS events are logged. */
+struct button_log_entry {
+	uint32_t uptime_s;
+	uint8_t button;
+	uint8_t evt;
+} __packed;
+
+typedef void (*button_log_cb_t)(const struct button_log_entry *entry, void *user_data);
+
+/* Mount the storage partition and load the counters. Called by button_init(). */
+int button_persist_init(void);
+
+/* Write pending counters and log entries now. On error they stay pending for the next flush. */
+int button_persist_flush(void);
+
+int button_persist_counters_get(uint8_t idx, struct button_persist_counters *counters);
+
+/* Visit the flushed log entries, oldest first. */
+int button_persist_log_foreach(button_log_cb_t cb, void *user_data);
+
+/* Number of flash records actually written since button_persist_init(). */
+uint32_t button_persist_write_count(void);
+
+/* Log entries discarded since button_persist_init() because flushes kept failing. */
+uint32_t button_persist_log_dropped(void);
+
+#endif /* _BUTTON_PERSIST_H_ */
@@ -0,0 +1,61 @@
+#ifndef _BUTTON_TIME_H_
+#define _BUTTON_TIME_H_
+#include <stdint.h>
+#include <zephyr/sys/time_units.h>
+#include <zephyr/sys/util.h>
+
+/*
+ * Cycle to time conversion for event timestamps and durations without 64-bit division.
+ *
+ * Each conversion is a 32.32 fixed-point multiplier precomputed from the cycle frequency, so
+ * converting costs two 32x32 multiplies. The multiplier is rounded up, so results are either
+ * equal to the matching k_cyc_to_*_floor32() or one unit above it.
+ */
+
+struct button_cyc_conv {
+	uint32_t whole;
+	uint32_t frac;
+};
+
+/* ceil((rate << 32) / hz), split into its integer and fractional words. */
+#define BUTTON_CYC_CONV_MULT(rate, hz) DIV_ROUND_UP((uint64_t)(rate) << 32, (uint64_t)(hz))
+#define BUTTON_CYC_CONV_INIT(rate, hz)                                                             \
+	{                                                                                          \
+		.whole = (uint32_t)(BUTTON_CYC_CONV_MULT(rate, hz) >> 32),                         \
+		.frac = (uint32_t)BUTTON_CYC_CONV_MULT(rate, hz),                                  \
+	}
+
+#ifdef CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME
+extern struct button_cyc_conv button_cyc_to_us_conv;
+extern struct button_cyc_conv button_cyc_to_ms_conv;
+
+/* Recompute the multipliers from the frequency the timer reports. Called by button_init(). */
+void button_time_init(void);
+#else
+/* The frequency is fixed, so the multipliers are constants folded into every conversion. */
+static const struct button_cyc_conv button_cyc_to_us_conv =
+	BUTTON_CYC_CONV_INIT(USEC_PER_SEC, CONFIG_SYS_CLOCK_HW_CYCLES_PER_SEC);
+static const struct button_cyc_conv button_cyc_to_ms_conv =
+	BUTTON_CYC_CONV_INIT(MSEC_PER_SEC, CONFIG_SYS_CLOCK_HW_CYCLES_PER_SEC);
+
+static inline void button_time_init(void)
+{
+}
+#endif
+
+static inline uint32_t button_cyc_conv_apply(const struct button_cyc_conv *conv, uint32_t cycles)
+{
+	return cycles * conv->whole + (uint32_t)(((uint64_t)cycles * conv->frac) >> 32);
+}
+
+static inline uint32_t button_cyc_to_us(uint32_t cycles)
+{
+	return button_cyc_conv_apply(&button_cyc_to_us_conv, cycles);
+}
+
+static inline uint32_t button_cyc_to_ms(uint32_t cycles)
+{
+	return button_cyc_conv_apply(&button_cyc_to_ms_conv, cycles);
+}
+
+#endif /* _BUTTON_TIME_H_ */
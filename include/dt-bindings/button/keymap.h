@@ -0,0 +1,22 @@
+#ifndef _DT_BINDINGS_BUTTON_KEYMAP_H_
+#define _DT_BINDINGS_BUTTON_KEYMAP_H_
+
+/* Event types for BUTTON_KEY(); the same values as enum button_evt_type. */
+#define BUTTON_KEY_PRESSED   1
+#define BUTTON_KEY_RELEASED  2
+#define BUTTON_KEY_LONGPRESS 3
+#define BUTTON_KEY_REPEAT    4
+#define BUTTON_KEY_HOLD      5
+
+/* One keymap entry: button index, event type and a non-zero action ID up to 0xfdff. */
+#define BUTTON_KEY(button, evt, action)                                                            \
+	((((button) & 0xff) << 24) | (((evt) & 0xff) << 16) | ((action) & 0xffff))
+
+/*
+ * Layer switching actions, consumed by the keymap instead of published. A momentary layer is
+ * active until the button that switched it on is released; a toggle layer flips on each event.
+ */
+#define BUTTON_LAYER_MO(layer) (0xff00 | ((layer) & 0xff))
+#define BUTTON_LAYER_TG(layer) (0xfe00 | ((layer) & 0xff))
+
+#endif /* _DT_BINDINGS_BUTTON_KEYMAP_H_ */
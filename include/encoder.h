@@ -0,0 +1,23 @@
+#ifndef _ENCODER_H_
+#define _ENCODER_H_
+#include <stdint.h>
+#include <zephyr/zbus/zbus.h>
+
+struct msg_encoder_evt {
+	/* Detents turned since the previous event, positive clockwise. */
+	int16_t detents;
+	/* Signed rotation speed in detents per second over the same period. */
+	int16_t velocity;
+	/* k_cycle_get_32() at the last detent included in the event. */
+	uint32_t timestamp;
+};
+
+ZBUS_CHAN_DECLARE(chan_encoder_evt);
+
+/* Idempotent; runs from the button SYS_INIT with CONFIG_BUTTON_AUTO_INIT. */
+int encoder_init(void);
+
+/* Quadrature transitions rejected because both phases changed at once. */
+uint32_t encoder_invalid_transitions(void);
+
+#endif /* _ENCODER_H_ */
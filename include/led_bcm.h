@@ -0,0 +1,23 @@
+#ifndef _LED_BCM_H_
+#define _LED_BCM_H_
+#include <stdint.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/sys/util.h>
+
+/* The gpio-leds node of the led0 alias; LED n is its n-th enabled child. */
+#define LED_NODE_LIST DT_PARENT(DT_ALIAS(led0))
+#define LED_COUNT     DT_CHILD_NUM_STATUS_OKAY(LED_NODE_LIST)
+
+/* Brightness runs from 0 (off) to LED_BCM_LEVELS - 1 (fully on). */
+#define LED_BCM_LEVELS BIT(CONFIG_LED_BCM_BITS)
+
+/* Idempotent; runs from its own APPLICATION level SYS_INIT. LEDs start off. */
+int led_bcm_init(void);
+
+/* -EINVAL for an unknown LED or a brightness of LED_BCM_LEVELS or more, -ENODEV before init. */
+int led_bcm_set(uint8_t led, uint8_t brightness);
+
+/* Timer interrupts since init: CONFIG_LED_BCM_BITS per frame while any LED is dimmed. */
+uint32_t led_bcm_wakeups(void);
+
+#endif /* _LED_BCM_H_ */
@@ -1,17 +1,24 @@
 #include "button.h"
+#include "button_obs.h"
+#include "button_persist.h"
+#include "button_priv.h"
+#include "button_trace.h"
+#include "button_time.h"
+#include "encoder.h"
 
+#include <errno.h>
 #include <zephyr/kernel.h>
-#include <zephyr/device.h>
-#include <zephyr/drivers/gpio.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/barrier.h>
 #include <zephyr/sys/util.h>
-#include <zephyr/sys/printk.h>
-#include <inttypes.h>
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_REGISTER(button, CONFIG_BUTTON_LOG_LEVEL);
 
 ZBUS_CHAN_DEFINE(chan_button_evt, struct msg_button_evt, NULL, NULL, ZBUS_OBSERVERS_EMPTY,
 		 ZBUS_MSG_INIT(.evt = BUTTON_EVT_UNDEFINED));
 
-#define SLEEP_TIME_MS 1
-
 /*
  * Get button configuration from the devicetree sw0 alias. This is mandatory.
  */
@@ -19,54 +26,551 @@ ZBUS_CHAN_DEFINE(chan_button_evt, struct msg_button_evt, NULL, NULL, ZBUS_OBSERV
 #if !DT_NODE_HAS_STATUS_OKAY(SW0_NODE)
 #error "Unsupported board: sw0 devicetree alias is not defined"
 #endif
-static const struct gpio_dt_spec button = GPIO_DT_SPEC_GET(SW0_NODE, gpios);
-static struct gpio_callback button_cb_data;
 
-void button_pressed(const struct device *dev, struct gpio_callback *cb, uint32_t pins)
+BUILD_ASSERT(BUTTON_COUNT <= 32, "button masks are 32 bits wide");
+
+#ifdef CONFIG_BUTTON_AUTO_INIT
+BUILD_ASSERT(CONFIG_BUTTON_INIT_PRIORITY > CONFIG_ZBUS_CHANNELS_SYS_INIT_PRIORITY,
+	     "buttons must initialise after zbus to publish their initial state");
+#endif
+
+/*
+ * Button state is shared between backend contexts (ISRs, work items, the input thread) that may
+ * run on different CPUs. The pressed bitmap and counters are atomics so readers never lock; the
+ * per-button spinlock only covers the level transition, its timestamp, the configuration latched
+ * for the current press and the hold level it reached.
+ *
+ * All hold levels of a press share the hold work item, which reschedules itself for the next
+ * threshold instead of arming one timer per level.
+ *
+ * Cancelling the repeat and hold work on release does not wait for a run already under way, so
+ * those handlers publish through button_publish_held(), which drops an event whose press ended.
+ */
+struct button_state {
+	struct k_spinlock lock;
+	uint32_t pressed_at;
+	struct button_cfg cfg;
+	uint8_t hold_level;
+	/* Incremented by every press, so a handler can tell the press it started for. */
+	uint32_t press_seq;
+	struct k_work_delayable repeat;
+	struct k_work_delayable hold;
+	atomic_t presses;
+	atomic_t releases;
+	atomic_t long_presses;
+	atomic_t recovered;
+};
+
+static ATOMIC_DEFINE(pressed, BUTTON_COUNT);
+static struct button_state states[BUTTON_COUNT];
+
+/*
+ * Seqlock protected copy of the debounced state for the button_is_pressed() family. seq is odd
+ * while a writer updates it and readers retry when it was odd or moved during their copy.
+ * Writers are serialised by snapshot_lock, which also masks interrupts, so a reader can never
+ * spin on a writer it preempted on the same CPU. Fences keep the data accesses between the two
+ * seq accesses on both sides, which weakly ordered SMP targets would otherwise reorder.
+ */
+static struct {
+	uint32_t mask;
+	uint32_t pressed_at[BUTTON_COUNT];
+} snapshot;
+static atomic_t snapshot_seq;
+static struct k_spinlock snapshot_lock;
+
+#ifdef CONFIG_BUTTON_WORKQ
+static K_THREAD_STACK_DEFINE(workq_stack, CONFIG_BUTTON_WORKQ_STACK_SIZE);
+static struct k_work_q workq;
+#endif
+
+/*
+ * Missed edge detection. While any button is pressed the reconcile pass compares debounced
+ * states with the pins; a button mismatched on two passes in a row is resynced through its
+ * backend and flagged in recovering so its next transition is published as recovered.
+ */
+static struct k_work_delayable reconcile_work;
+static ATOMIC_DEFINE(recovering, BUTTON_COUNT);
+/* Only touched by reconcile_work. */
+static uint32_t reconcile_suspects;
+
+/*
+ * Events are queued in button_evt_queue and only publish_work publishes them, so publishes on
+ * chan_button_evt never contend and listeners run on the button work queue with interrupts
+ * enabled. Each event is queued under the lock of its button, which orders a REPEAT or HOLD
+ * against the RELEASED of its press. A full queue drops the event.
+ */
+K_MSGQ_DEFINE(button_evt_queue, sizeof(struct msg_button_evt), CONFIG_BUTTON_EVT_QUEUE_SIZE, 4);
+static struct k_work publish_work;
+
+/* button_init() progress; callers arriving while it runs get -EBUSY. */
+enum {
+	INIT_NONE,
+	INIT_BUSY,
+	INIT_DONE,
+};
+
+static atomic_t init_state;
+/* Survives a failed button_init(): the work queue thread cannot be started twice. */
+static bool work_ready;
+static atomic_t interrupts_enabled;
+static uint32_t boot_mask;
+static uint32_t ready_cycles;
+
+static void button_publish_handler(struct k_work *work)
 {
-	struct msg_button_evt msg = {.evt = BUTTON_EVT_UNDEFINED};
+	struct msg_button_evt msg;
+	int ret;
+
+	while (k_msgq_get(&button_evt_queue, &msg, K_NO_WAIT) == 0) {
+		BUTTON_TRACE_PUBLISH_ENTER(msg.button, msg.evt);
+		ret = button_obs_evt_pub(&msg, K_MSEC(CONFIG_BUTTON_PUBLISH_TIMEOUT_MS));
+		BUTTON_TRACE_PUBLISH_EXIT(msg.button, ret);
+
+		if (ret != 0) {
+			LOG_WRN("Error %d: event %d of button %u dropped", ret, msg.evt,
+				msg.button);
+		}
+	}
+}
 
-	if (gpio_pin_get_dt(&button)) {
-		msg.evt = BUTTON_EVT_PRESSED;
-		printk("Button pressed at %" PRIu32 "\n", k_cycle_get_32());
+/* Safe from any context; only holds the message queue lock. */
+static void button_publish_msg(const struct msg_button_evt *msg)
+{
+	if (k_msgq_put(&button_evt_queue, msg, K_NO_WAIT) != 0) {
+		LOG_WRN("Event %d of button %u dropped, queue full", msg->evt, msg->button);
+		return;
+	}
+
+	k_work_submit_to_queue(button_workq(), &publish_work);
+}
+
+/*
+ * Queues an event of press number seq if that press is still going on. The check and the put
+ * are made under the lock of the button, which the release needs before it queues its RELEASED,
+ * so the event is either queued before it or not at all.
+ */
+static bool button_publish_held(struct button_state *state, uint32_t seq,
+				const struct msg_button_evt *msg)
+{
+	k_spinlock_key_t key = k_spin_lock(&state->lock);
+	bool held = atomic_test_bit(pressed, msg->button) && state->press_seq == seq;
+
+	if (held) {
+		button_publish_msg(msg);
+	}
+	k_spin_unlock(&state->lock, key);
+
+	return held;
+}
+
+static void button_snapshot_set(uint8_t idx, bool is_pressed, uint32_t now)
+{
+	k_spinlock_key_t key = k_spin_lock(&snapshot_lock);
+
+	atomic_inc(&snapshot_seq);
+	barrier_dmem_fence_full();
+	WRITE_BIT(snapshot.mask, idx, is_pressed);
+	snapshot.pressed_at[idx] = now;
+	barrier_dmem_fence_full();
+	atomic_inc(&snapshot_seq);
+	k_spin_unlock(&snapshot_lock, key);
+}
+
+/* Returns the pressed mask; pressed_at of idx is copied in the same read when requested. */
+static uint32_t button_snapshot_get(uint8_t idx, uint32_t *pressed_at)
+{
+	atomic_val_t seq;
+	uint32_t mask;
+
+	do {
+		seq = atomic_get(&snapshot_seq);
+		barrier_dmem_fence_full();
+		mask = snapshot.mask;
+		if (pressed_at != NULL) {
+			*pressed_at = snapshot.pressed_at[idx];
+		}
+		barrier_dmem_fence_full();
+	} while ((seq & 1) != 0 || atomic_get(&snapshot_seq) != seq);
+
+	return mask;
+}
+
+static void button_repeat_handler(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct button_state *state = CONTAINER_OF(dwork, struct button_state, repeat);
+	struct msg_button_evt msg = {.evt = BUTTON_EVT_REPEAT, .button = state - states};
+	k_spinlock_key_t key;
+	uint16_t interval;
+	uint16_t delay;
+	uint32_t held_ms;
+	uint32_t seq;
+
+	key = k_spin_lock(&state->lock);
+	if (!atomic_test_bit(pressed, msg.button)) {
+		k_spin_unlock(&state->lock, key);
+		return;
+	}
+	msg.timestamp = k_cycle_get_32();
+	held_ms = button_cyc_to_ms(msg.timestamp - state->pressed_at);
+	interval = state->cfg.repeat_interval_ms;
+	delay = state->cfg.repeat_delay_ms;
+	seq = state->press_seq;
+	k_spin_unlock(&state->lock, key);
+
+	/* A run left over from the previous press, which the new press has rescheduled. */
+	if (delay == 0 || held_ms < delay) {
+		return;
+	}
+
+	BUTTON_TRACE_GESTURE(msg.button, BUTTON_EVT_REPEAT);
+	if (button_publish_held(state, seq, &msg)) {
+		k_work_schedule_for_queue(button_workq(), &state->repeat, K_MSEC(interval));
+	}
+}
+
+static void button_hold_handler(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct button_state *state = CONTAINER_OF(dwork, struct button_state, hold);
+	struct msg_button_evt msg = {.evt = BUTTON_EVT_HOLD, .button = state - states};
+	k_spinlock_key_t key;
+	uint16_t next = 0;
+	uint32_t seq;
+
+	key = k_spin_lock(&state->lock);
+	if (!atomic_test_bit(pressed, msg.button) || state->hold_level >= BUTTON_HOLD_LEVELS) {
+		k_spin_unlock(&state->lock, key);
+		return;
+	}
+	msg.timestamp = k_cycle_get_32();
+	msg.held_ms = button_cyc_to_ms(msg.timestamp - state->pressed_at);
+	if (state->cfg.hold_ms[state->hold_level] == 0 ||
+	    msg.held_ms < state->cfg.hold_ms[state->hold_level]) {
+		/* Left over from the previous press, which the new press has rescheduled. */
+		k_spin_unlock(&state->lock, key);
+		return;
+	}
+	msg.hold_level = ++state->hold_level;
+	if (state->hold_level < BUTTON_HOLD_LEVELS) {
+		next = state->cfg.hold_ms[state->hold_level];
+	}
+	seq = state->press_seq;
+	k_spin_unlock(&state->lock, key);
+
+	BUTTON_TRACE_GESTURE(msg.button, BUTTON_EVT_HOLD);
+	if (!button_publish_held(state, seq, &msg)) {
+		return;
+	}
+
+	/* A late run shortens the wait so the next level stays anchored to the press. */
+	if (next > 0) {
+		k_work_schedule_for_queue(button_workq(), &state->hold,
+					  K_MSEC(next > msg.held_ms ? next - msg.held_ms : 0));
+	}
+}
+
+static void button_transition(uint8_t idx, bool is_pressed, uint8_t flags)
+{
+	struct msg_button_evt msg = {.button = idx, .flags = flags};
+	struct button_state *state;
+	struct button_cfg cfg;
+	k_spinlock_key_t key;
+	bool long_press = false;
+
+	if (idx >= BUTTON_COUNT) {
+		return;
+	}
+
+	state = &states[idx];
+
+	if (is_pressed) {
+		(void)button_cfg_get(idx, &cfg);
+	}
+
+	key = k_spin_lock(&state->lock);
+	if (atomic_test_bit(pressed, idx) == is_pressed) {
+		k_spin_unlock(&state->lock, key);
+		return;
+	}
+	msg.timestamp = k_cycle_get_32();
+	if (is_pressed) {
+		state->pressed_at = msg.timestamp;
+		state->cfg = cfg;
+		state->hold_level = 0;
+		state->press_seq++;
 	} else {
-		msg.evt = BUTTON_EVT_RELEASED;
-		printk("Button released at %" PRIu32 "\n", k_cycle_get_32());
+		cfg = state->cfg;
+		msg.held_ms = button_cyc_to_ms(msg.timestamp - state->pressed_at);
+		long_press = msg.held_ms >= cfg.long_press_ms;
+	}
+	atomic_set_bit_to(pressed, idx, is_pressed);
+	button_snapshot_set(idx, is_pressed, msg.timestamp);
+
+	if (atomic_test_and_clear_bit(recovering, idx)) {
+		msg.flags |= BUTTON_EVT_FLAG_RECOVERED;
+		atomic_inc(&state->recovered);
+	}
+	atomic_inc(is_pressed ? &state->presses : &state->releases);
+
+	/* Queued before the unlock, so no REPEAT or HOLD of the press can follow the RELEASED. */
+	msg.evt = is_pressed ? BUTTON_EVT_PRESSED : BUTTON_EVT_RELEASED;
+	button_publish_msg(&msg);
+	if (long_press) {
+		BUTTON_TRACE_GESTURE(idx, BUTTON_EVT_LONGPRESS);
+		atomic_inc(&state->long_presses);
+		msg.evt = BUTTON_EVT_LONGPRESS;
+		msg.flags = 0;
+		button_publish_msg(&msg);
+	}
+	k_spin_unlock(&state->lock, key);
+
+	if (is_pressed) {
+		LOG_DBG("Button %u pressed at %u", idx, msg.timestamp);
+		if (cfg.repeat_delay_ms > 0) {
+			k_work_reschedule_for_queue(button_workq(), &state->repeat,
+						    K_MSEC(cfg.repeat_delay_ms));
+		}
+		if (cfg.hold_ms[0] > 0) {
+			k_work_reschedule_for_queue(button_workq(), &state->hold,
+						    K_MSEC(cfg.hold_ms[0]));
+		}
+		if (CONFIG_BUTTON_RECONCILE_MS > 0) {
+			/* Already scheduled while another button is held. */
+			k_work_schedule_for_queue(button_workq(), &reconcile_work,
+						  K_MSEC(CONFIG_BUTTON_RECONCILE_MS));
+		}
+		return;
+	}
+
+	(void)k_work_cancel_delayable(&state->repeat);
+	(void)k_work_cancel_delayable(&state->hold);
+
+	LOG_DBG("Button %u released at %u after %u ms", idx, msg.timestamp, msg.held_ms);
+}
+
+static void button_reconcile_handler(struct k_work *work)
+{
+	uint32_t mask = button_pressed_mask();
+	uint32_t mismatched = 0;
+	uint32_t lost;
+
+	/* Stale marks from a resync whose level bounced back before it was reported. */
+	ARRAY_FOR_EACH(states, i) {
+		atomic_clear_bit(recovering, i);
+	}
+
+	ARRAY_FOR_EACH(states, i) {
+		int level = button_backend_get(i);
+
+		if (level >= 0 && level != ((mask & BIT(i)) != 0)) {
+			mismatched |= BIT(i);
+		}
+	}
+
+	/* A debounce in progress explains one mismatch; the same one a period later does not. */
+	lost = mismatched & reconcile_suspects;
+	reconcile_suspects = mismatched & ~lost;
+
+	ARRAY_FOR_EACH(states, i) {
+		if (lost & BIT(i)) {
+			LOG_WRN("Button %d missed an edge, resyncing", i);
+			atomic_set_bit(recovering, i);
+			button_backend_resync(i);
+		}
 	}
 
-	zbus_chan_pub(&chan_button_evt, &msg, K_NO_WAIT);
+	/* After a resync, one more pass clears its mark if it did not end in a transition. */
+	if (button_pressed_mask() != 0 || reconcile_suspects != 0 || lost != 0) {
+		k_work_schedule_for_queue(button_workq(), &reconcile_work,
+					  K_MSEC(CONFIG_BUTTON_RECONCILE_MS));
+	}
+}
+
+struct k_work_q *button_workq(void)
+{
+#ifdef CONFIG_BUTTON_WORKQ
+	return &workq;
+#else
+	return &k_sys_work_q;
+#endif
+}
+
+void button_core_report(uint8_t idx, bool is_pressed)
+{
+	button_transition(idx, is_pressed, 0);
+}
+
+int button_stats_get(uint8_t idx, struct button_stats *stats)
+{
+	if (idx >= BUTTON_COUNT || stats == NULL) {
+		return -EINVAL;
+	}
+
+	stats->presses = atomic_get(&states[idx].presses);
+	stats->releases = atomic_get(&states[idx].releases);
+	stats->long_presses = atomic_get(&states[idx].long_presses);
+	stats->recovered = atomic_get(&states[idx].recovered);
+	stats->debounce_mode = button_backend_debounce_mode(idx);
+
+	return 0;
+}
+
+bool button_is_pressed(uint8_t idx)
+{
+	return idx < BUTTON_COUNT && (button_snapshot_get(0, NULL) & BIT(idx)) != 0;
+}
+
+uint32_t button_pressed_mask(void)
+{
+	return button_snapshot_get(0, NULL);
+}
+
+uint32_t button_held_for(uint8_t idx)
+{
+	uint32_t pressed_at;
+
+	if (idx >= BUTTON_COUNT) {
+		return 0;
+	}
+
+	if ((button_snapshot_get(idx, &pressed_at) & BIT(idx)) == 0) {
+		return 0;
+	}
+
+	return button_cyc_to_ms(k_cycle_get_32() - pressed_at);
+}
+
+/* Seed the state of every button from its current level and publish it. */
+static void button_sample_all(void)
+{
+	ARRAY_FOR_EACH(states, i) {
+		int level = button_backend_get(i);
+
+		if (level < 0) {
+			LOG_ERR("Error %d: failed to sample button %d", level, i);
+			continue;
+		}
+
+		if (level) {
+			boot_mask |= BIT(i);
+			button_transition(i, true, BUTTON_EVT_FLAG_INITIAL);
+		} else {
+			/* Nothing to transition from, but subscribers still learn the level. */
+			struct msg_button_evt msg = {.evt = BUTTON_EVT_RELEASED,
+						     .button = i,
+						     .flags = BUTTON_EVT_FLAG_INITIAL,
+						     .timestamp = k_cycle_get_32()};
+
+			button_publish_msg(&msg);
+		}
+	}
+}
+
+static void button_work_init(void)
+{
+#ifdef CONFIG_BUTTON_WORKQ
+	k_work_queue_start(&workq, workq_stack, K_THREAD_STACK_SIZEOF(workq_stack),
+			   CONFIG_BUTTON_WORKQ_PRIORITY,
+			   &(const struct k_work_queue_config){.name = "button_workq"});
+#endif
+
+	ARRAY_FOR_EACH(states, i) {
+		k_work_init_delayable(&states[i].repeat, button_repeat_handler);
+		k_work_init_delayable(&states[i].hold, button_hold_handler);
+	}
+	k_work_init_delayable(&reconcile_work, button_reconcile_handler);
+	k_work_init(&publish_work, button_publish_handler);
 }
 
 int button_init(void)
 {
+	struct k_work_sync sync;
 	int ret;
 
-	if (!gpio_is_ready_dt(&button)) {
-		printk("Error: button device %s is not ready\n", button.port->name);
-		return -ENODEV;
+	if (!atomic_cas(&init_state, INIT_NONE, INIT_BUSY)) {
+		return atomic_get(&init_state) == INIT_DONE ? 0 : -EBUSY;
 	}
 
-	ret = gpio_pin_configure_dt(&button, GPIO_INPUT);
+	button_time_init();
+
+	if (!work_ready) {
+		button_work_init();
+		work_ready = true;
+	}
+
+	if (IS_ENABLED(CONFIG_BUTTON_PERSIST)) {
+		ret = button_persist_init();
+		if (ret != 0) {
+			atomic_set(&init_state, INIT_NONE);
+			return ret;
+		}
+	}
+
+	ret = button_backend_init();
 	if (ret != 0) {
-		printk("Error %d: failed to configure %s pin %d\n", ret, button.port->name,
-		       button.pin);
+		atomic_set(&init_state, INIT_NONE);
 		return ret;
 	}
 
+	button_sample_all();
+	/* The initial events are out once init returns. */
+	(void)k_work_flush(&publish_work, &sync);
+
+	ready_cycles = k_cycle_get_32();
+	LOG_INF("Buttons ready %u us after reset, held at boot 0x%x",
+		button_cyc_to_us(ready_cycles), boot_mask);
+	atomic_set(&init_state, INIT_DONE);
+
 	return 0;
 }
 
 int button_enable_interrupts(void)
 {
-	int ret = gpio_pin_interrupt_configure_dt(&button, GPIO_INT_EDGE_BOTH);
+	int ret;
+
+	if (atomic_set(&interrupts_enabled, 1)) {
+		return 0;
+	}
+
+	ret = button_backend_enable();
+	if (ret != 0) {
+		atomic_clear(&interrupts_enabled);
+	}
+
+	return ret;
+}
+
+uint32_t button_boot_mask(void)
+{
+	return boot_mask;
+}
+
+uint32_t button_ready_cycles(void)
+{
+	return ready_cycles;
+}
+
+#ifdef CONFIG_BUTTON_AUTO_INIT
+static int button_sys_init(void)
+{
+	int ret = button_init();
+
+	if (ret != 0) {
+		return ret;
+	}
+
+	ret = button_enable_interrupts();
 	if (ret != 0) {
-		printk("Error %d: failed to configure interrupt on %s pin %d\n", ret,
-		       button.port->name, button.pin);
 		return ret;
 	}
 
-	gpio_init_callback(&button_cb_data, button_pressed, BIT(button.pin));
-	gpio_add_callback(button.port, &button_cb_data);
+	if (IS_ENABLED(CONFIG_ENCODER)) {
+		ret = encoder_init();
+	}
 
-	return 0;
+	return ret;
 }
+
+SYS_INIT(button_sys_init, APPLICATION, CONFIG_BUTTON_INIT_PRIORITY);
+#endif
@@ -0,0 +1,195 @@
+#include "button.h"
+#include "button_priv.h"
+#include "button_trace.h"
+
+#include <stdlib.h>
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/adc.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_DECLARE(button, CONFIG_BUTTON_LOG_LEVEL);
+
+/*
+ * Resistor ladder backend. Uses the adc-keys binding: the node's io-channels is sampled every
+ * sample-period-ms while a key may be down, the reading is classified to the nearest of keyup-mv
+ * and the children's press-thresholds-mv, and a classification is reported once it was seen for
+ * the whole debounce time. Several children may share a threshold to describe key combinations.
+ */
+
+#define SAMPLE_PERIOD_MS DT_PROP(BUTTON_NODE_LIST, sample_period_ms)
+#define KEYUP_MV         DT_PROP(BUTTON_NODE_LIST, keyup_mv)
+
+struct ladder_level {
+	int32_t mv;
+	uint32_t mask;
+};
+
+#define LADDER_LEVEL(node, prop, i)                                                                \
+	{.mv = DT_PROP_BY_IDX(node, prop, i), .mask = BIT(DT_NODE_CHILD_IDX(node))},
+#define LADDER_LEVELS(node) DT_FOREACH_PROP_ELEM(node, press_thresholds_mv, LADDER_LEVEL)
+
+/* Thresholds straight from devicetree; duplicates are merged by classification. */
+static const struct ladder_level levels[] = {
+	{.mv = KEYUP_MV, .mask = 0},
+	DT_FOREACH_CHILD_STATUS_OKAY(BUTTON_NODE_LIST, LADDER_LEVELS)};
+
+static const struct adc_dt_spec adc = ADC_DT_SPEC_GET(BUTTON_NODE_LIST);
+
+static struct k_work_delayable sample_work;
+static uint32_t candidate;
+static uint32_t candidate_since;
+static uint32_t reported;
+
+static int ladder_read_mv(int32_t *mv)
+{
+	int16_t raw;
+	struct adc_sequence seq = {
+		.buffer = &raw,
+		.buffer_size = sizeof(raw),
+	};
+	int ret;
+
+	adc_sequence_init_dt(&adc, &seq);
+
+	ret = adc_read_dt(&adc, &seq);
+	if (ret != 0) {
+		return ret;
+	}
+
+	*mv = raw;
+
+	return adc_raw_to_millivolts_dt(&adc, mv);
+}
+
+/* Mask of the buttons whose threshold is nearest to mv; 0 when key-up is nearest. */
+static uint32_t ladder_classify(int32_t mv)
+{
+	int32_t best = INT32_MAX;
+	uint32_t mask = 0;
+
+	ARRAY_FOR_EACH(levels, i) {
+		int32_t dist = abs(mv - levels[i].mv);
+
+		if (dist < best) {
+			best = dist;
+			mask = levels[i].mask;
+		} else if (dist == best) {
+			mask |= levels[i].mask;
+		}
+	}
+
+	return mask;
+}
+
+static void ladder_sample_handler(struct k_work *work)
+{
+	uint32_t now = k_uptime_get_32();
+	struct button_cfg cfg;
+	uint32_t changed;
+	uint32_t mask;
+	int32_t mv;
+	int ret;
+
+	ret = ladder_read_mv(&mv);
+	if (ret != 0) {
+		LOG_ERR("Error %d: failed to read %s channel %d", ret, adc.dev->name,
+			adc.channel_id);
+		k_work_schedule_for_queue(button_workq(), &sample_work,
+					  K_MSEC(CONFIG_BUTTON_ADC_IDLE_PERIOD_MS));
+		return;
+	}
+
+	mask = ladder_classify(mv);
+	if (mask != candidate) {
+		BUTTON_TRACE_DEBOUNCE_START(find_lsb_set(mask ^ candidate) - 1);
+		candidate = mask;
+		candidate_since = now;
+	}
+
+	/* The whole ladder shares one signal, so it settles on the first button's debounce. */
+	(void)button_cfg_get(0, &cfg);
+
+	changed = candidate ^ reported;
+	if (changed != 0 && now - candidate_since >= cfg.debounce_ms) {
+		reported = candidate;
+		while (changed != 0) {
+			uint8_t idx = find_lsb_set(changed) - 1;
+
+			BUTTON_TRACE_DEBOUNCE_SETTLE(idx, (reported >> idx) & 1);
+			button_core_report(idx, reported & BIT(idx));
+			changed &= ~BIT(idx);
+		}
+	}
+
+	/* Sample fast while anything is down or settling, slowly while the ladder idles. */
+	k_work_schedule_for_queue(button_workq(), &sample_work,
+				  K_MSEC((candidate | reported) ? SAMPLE_PERIOD_MS
+								: CONFIG_BUTTON_ADC_IDLE_PERIOD_MS));
+}
+
+int button_backend_init(void)
+{
+	int32_t mv;
+	int ret;
+
+	if (!adc_is_ready_dt(&adc)) {
+		LOG_ERR("Error: ADC device %s is not ready", adc.dev->name);
+		return -ENODEV;
+	}
+
+	ret = adc_channel_setup_dt(&adc);
+	if (ret != 0) {
+		LOG_ERR("Error %d: failed to set up %s channel %d", ret, adc.dev->name,
+			adc.channel_id);
+		return ret;
+	}
+
+	ret = ladder_read_mv(&mv);
+	if (ret != 0) {
+		LOG_ERR("Error %d: failed to read %s channel %d", ret, adc.dev->name,
+			adc.channel_id);
+		return ret;
+	}
+
+	/* Start from what init reports, so a key released before the first sample is reported. */
+	reported = ladder_classify(mv);
+	candidate = reported;
+	candidate_since = k_uptime_get_32();
+
+	k_work_init_delayable(&sample_work, ladder_sample_handler);
+
+	return 0;
+}
+
+int button_backend_get(uint8_t idx)
+{
+	int32_t mv;
+	int ret = ladder_read_mv(&mv);
+
+	if (ret != 0) {
+		return ret;
+	}
+
+	return (ladder_classify(mv) & BIT(idx)) != 0;
+}
+
+void button_backend_resync(uint8_t idx)
+{
+	/* One sample classifies every key. */
+	k_work_reschedule_for_queue(button_workq(), &sample_work, K_NO_WAIT);
+}
+
+enum button_debounce_mode button_backend_debounce_mode(uint8_t idx)
+{
+	return BUTTON_DEBOUNCE_MODE_SOFTWARE;
+}
+
+int button_backend_enable(void)
+{
+	/* A key held at boot was already reported by init; the core drops the repeat. */
+	k_work_schedule_for_queue(button_workq(), &sample_work, K_NO_WAIT);
+
+	return 0;
+}
@@ -0,0 +1,118 @@
+#include "button.h"
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/barrier.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_DECLARE(button, CONFIG_BUTTON_LOG_LEVEL);
+
+#define BUTTON_CFG_DEFAULT(node)                                                                   \
+	{                                                                                          \
+		.debounce_ms = BUTTON_DEBOUNCE_MS_DEFAULT,                                         \
+		.long_press_ms = CONFIG_BUTTON_LONG_PRESS_MS,                                      \
+		.repeat_delay_ms = CONFIG_BUTTON_REPEAT_DELAY_MS,                                  \
+		.repeat_interval_ms = CONFIG_BUTTON_REPEAT_INTERVAL_MS,                            \
+		.hold_ms = {CONFIG_BUTTON_HOLD_1_MS, CONFIG_BUTTON_HOLD_2_MS,                      \
+			    CONFIG_BUTTON_HOLD_3_MS},                                              \
+	}
+
+/*
+ * Double-buffered configuration. Readers use cfgs[generation & 1]; a writer fills the other
+ * buffer and then bumps generation, which is the only store readers observe. A reader that sees
+ * generation move while copying may have raced a second writer into its buffer, and retries.
+ * Fences keep the copy between the two generation loads and the buffer stores before the bump.
+ */
+static struct button_cfg cfgs[2][BUTTON_COUNT] = {
+	{DT_FOREACH_CHILD_STATUS_OKAY_SEP(BUTTON_NODE_LIST, BUTTON_CFG_DEFAULT, (,))},
+};
+static atomic_t generation;
+
+/* Serialises writers only. */
+static struct k_spinlock write_lock;
+
+int button_cfg_get(uint8_t idx, struct button_cfg *cfg)
+{
+	atomic_val_t gen;
+
+	if (idx >= BUTTON_COUNT || cfg == NULL) {
+		return -EINVAL;
+	}
+
+	do {
+		gen = atomic_get(&generation);
+		barrier_dmem_fence_full();
+		*cfg = cfgs[gen & 1][idx];
+		barrier_dmem_fence_full();
+	} while (atomic_get(&generation) != gen);
+
+	return 0;
+}
+
+static bool button_cfg_holds_valid(const struct button_cfg *cfg)
+{
+	for (int i = 1; i < BUTTON_HOLD_LEVELS; i++) {
+		if (cfg->hold_ms[i] != 0 && cfg->hold_ms[i] <= cfg->hold_ms[i - 1]) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static bool button_cfg_valid(const struct button_cfg *cfg)
+{
+	return cfg->debounce_ms > 0 && (cfg->repeat_delay_ms == 0 || cfg->repeat_interval_ms > 0) &&
+	       button_cfg_holds_valid(cfg);
+}
+
+int button_cfg_set(uint8_t idx, const struct button_cfg *cfg)
+{
+	k_spinlock_key_t key;
+	atomic_val_t gen;
+
+	if ((idx >= BUTTON_COUNT && idx != BUTTON_CFG_ALL) || cfg == NULL ||
+	    !button_cfg_valid(cfg)) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&write_lock);
+	gen = atomic_get(&generation);
+	memcpy(cfgs[(gen + 1) & 1], cfgs[gen & 1], sizeof(cfgs[0]));
+	if (idx == BUTTON_CFG_ALL) {
+		for (int i = 0; i < BUTTON_COUNT; i++) {
+			cfgs[(gen + 1) & 1][i] = *cfg;
+		}
+	} else {
+		cfgs[(gen + 1) & 1][idx] = *cfg;
+	}
+	barrier_dmem_fence_full();
+	atomic_inc(&generation);
+	k_spin_unlock(&write_lock, key);
+
+	return 0;
+}
+
+static bool button_cfg_validator(const void *msg, size_t msg_size)
+{
+	const struct msg_button_cfg *m = msg;
+
+	return (m->button < BUTTON_COUNT || m->button == BUTTON_CFG_ALL) &&
+	       button_cfg_valid(&m->cfg);
+}
+
+static void button_cfg_listener_cb(const struct zbus_channel *chan)
+{
+	const struct msg_button_cfg *m = zbus_chan_const_msg(chan);
+
+	(void)button_cfg_set(m->button, &m->cfg);
+}
+
+ZBUS_LISTENER_DEFINE(button_cfg_lis, button_cfg_listener_cb);
+
+ZBUS_CHAN_DEFINE(chan_button_cfg, struct msg_button_cfg, button_cfg_validator, NULL,
+		 ZBUS_OBSERVERS(button_cfg_lis), ZBUS_MSG_INIT(.button = BUTTON_CFG_ALL));
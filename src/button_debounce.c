@@ -0,0 +1,75 @@
+#include "button_debounce.h"
+
+#include <zephyr/sys/util.h>
+
+static uint16_t integrator_max(const struct button_debounce_cfg *cfg, uint16_t debounce_ms)
+{
+	return MAX(debounce_ms / cfg->period_ms, 1);
+}
+
+static uint32_t majority_mask(const struct button_debounce_cfg *cfg)
+{
+	return cfg->window >= 32 ? UINT32_MAX : BIT(cfg->window) - 1;
+}
+
+void button_debounce_reset(const struct button_debounce_cfg *cfg, struct button_debounce *d,
+			   bool level, uint16_t debounce_ms)
+{
+	d->level = level;
+	d->count = level ? integrator_max(cfg, debounce_ms) : 0;
+	d->history = level ? majority_mask(cfg) : 0;
+}
+
+static bool integrator_sample(const struct button_debounce_cfg *cfg, struct button_debounce *d,
+			      bool raw, uint16_t debounce_ms)
+{
+	uint16_t max = integrator_max(cfg, debounce_ms);
+
+	/* debounce_ms may have shrunk since the last sample. */
+	d->count = MIN(d->count, max);
+	if (raw && d->count < max) {
+		d->count++;
+	} else if (!raw && d->count > 0) {
+		d->count--;
+	}
+
+	if (d->count == max) {
+		d->level = true;
+	} else if (d->count == 0) {
+		d->level = false;
+	}
+
+	return d->count != (d->level ? max : 0);
+}
+
+static bool majority_sample(const struct button_debounce_cfg *cfg, struct button_debounce *d,
+			    bool raw)
+{
+	uint32_t mask = majority_mask(cfg);
+	uint32_t ones;
+
+	d->history = ((d->history << 1) | raw) & mask;
+	ones = __builtin_popcount(d->history);
+
+	if (!d->level && ones >= cfg->threshold) {
+		d->level = true;
+	} else if (d->level && cfg->window - ones >= cfg->threshold) {
+		d->level = false;
+	}
+
+	return d->history != (d->level ? mask : 0);
+}
+
+bool button_debounce_sample(const struct button_debounce_cfg *cfg, struct button_debounce *d,
+			    bool raw, uint16_t debounce_ms)
+{
+	switch (cfg->algo) {
+	case BUTTON_DEBOUNCE_INTEGRATOR:
+		return integrator_sample(cfg, d, raw, debounce_ms);
+	case BUTTON_DEBOUNCE_MAJORITY:
+		return majority_sample(cfg, d, raw);
+	default:
+		d->level = raw;
+		return false;
+	}
+}
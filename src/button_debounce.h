@@ -0,0 +1,51 @@
+#ifndef _BUTTON_DEBOUNCE_H_
+#define _BUTTON_DEBOUNCE_H_
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Sampled debounce algorithms of the GPIO backend. They are pure functions of the samples fed to
+ * them so recorded traces can be replayed through the same code. The settle timer and the eager
+ * (leading-edge) mode are driven by edges instead and need no state here; none has no debounce.
+ */
+
+/* Same order as the algorithm enum of the button-debounce binding. */
+enum button_debounce_algo {
+	BUTTON_DEBOUNCE_SETTLE,
+	BUTTON_DEBOUNCE_INTEGRATOR,
+	BUTTON_DEBOUNCE_MAJORITY,
+	BUTTON_DEBOUNCE_EAGER,
+	BUTTON_DEBOUNCE_NONE,
+};
+
+struct button_debounce_cfg {
+	uint8_t algo;
+	uint8_t period_ms;
+	/* Majority vote: threshold of the last window samples. */
+	uint8_t window;
+	uint8_t threshold;
+	/* Eager: time an edge must hold before it is reported, 0 reports it from the ISR. */
+	uint16_t glitch_us;
+};
+
+struct button_debounce {
+	/* Debounced level. */
+	bool level;
+	/* Integrator count, 0 .. debounce_ms / period_ms. */
+	uint16_t count;
+	/* Majority vote samples, newest in bit 0. */
+	uint32_t history;
+};
+
+/* Start from a known stable level. */
+void button_debounce_reset(const struct button_debounce_cfg *cfg, struct button_debounce *d,
+			   bool level, uint16_t debounce_ms);
+
+/*
+ * Feed one sample taken period_ms after the previous one. Returns true while more samples are
+ * needed, false once they all agree with d->level.
+ */
+bool button_debounce_sample(const struct button_debounce_cfg *cfg, struct button_debounce *d,
+			    bool raw, uint16_t debounce_ms);
+
+#endif /* _BUTTON_DEBOUNCE_H_ */
@@ -0,0 +1,444 @@
+#include "button.h"
+#include "button_debounce.h"
+#include "button_priv.h"
+#include "button_trace.h"
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_DECLARE(button, CONFIG_BUTTON_LOG_LEVEL);
+
+#define BUTTON_GPIO_SPEC(node) GPIO_DT_SPEC_GET(node, gpios)
+
+static const struct gpio_dt_spec buttons[] = {
+	DT_FOREACH_CHILD_STATUS_OKAY_SEP(BUTTON_NODE_LIST, BUTTON_GPIO_SPEC, (,))};
+
+#ifdef CONFIG_BUTTON_HW_DEBOUNCE
+#define HW_DEBOUNCE_FLAGS CONFIG_BUTTON_HW_DEBOUNCE_FLAGS
+BUILD_ASSERT(HW_DEBOUNCE_FLAGS != 0 && (HW_DEBOUNCE_FLAGS & ~0xff00) == 0,
+	     "CONFIG_BUTTON_HW_DEBOUNCE_FLAGS must be a controller specific flag, bits 8-15");
+#else
+#define HW_DEBOUNCE_FLAGS 0
+#endif
+
+/* gpio-emul keeps whatever flags it is given and filters nothing. */
+#define HW_DEBOUNCE_IGNORED(node) DT_NODE_HAS_COMPAT(DT_GPIO_CTLR(node, gpios), zephyr_gpio_emul)
+
+static const bool hw_debounce_ignored[] = {
+	DT_FOREACH_CHILD_STATUS_OKAY_SEP(BUTTON_NODE_LIST, HW_DEBOUNCE_IGNORED, (,))};
+
+/* Children of a button-debounce node override the settle timer of the button they point to. */
+#define DEBOUNCE_NODE DT_COMPAT_GET_ANY_STATUS_OKAY(button_debounce)
+
+#define DEBOUNCE_CFG(node)                                                                         \
+	[DT_NODE_CHILD_IDX(DT_PHANDLE(node, button))] = {                                          \
+		.algo = DT_ENUM_IDX(node, algorithm),                                              \
+		.period_ms = DT_PROP(node, sample_period_ms),                                      \
+		.window = DT_PROP(node, window),                                                   \
+		.threshold = DT_PROP(node, threshold),                                             \
+		.glitch_us = DT_PROP(node, glitch_reject_us),                                      \
+	},
+
+#define DEBOUNCE_CFG_CHECK(node)                                                                   \
+	BUILD_ASSERT(DT_SAME_NODE(DT_PARENT(DT_PHANDLE(node, button)), BUTTON_NODE_LIST),          \
+		     "button-debounce entry for a node outside the button list");                  \
+	BUILD_ASSERT(DT_PROP(node, sample_period_ms) > 0 && DT_PROP(node, window) <= 32 &&         \
+			     DT_PROP(node, threshold) * 2 > DT_PROP(node, window) &&               \
+			     DT_PROP(node, threshold) <= DT_PROP(node, window),                    \
+		     "invalid button-debounce parameters");
+
+static const struct button_debounce_cfg debounce_cfgs[BUTTON_COUNT] = {
+#if DT_NODE_EXISTS(DEBOUNCE_NODE)
+	DT_FOREACH_CHILD(DEBOUNCE_NODE, DEBOUNCE_CFG)
+#endif
+};
+
+#if DT_NODE_EXISTS(DEBOUNCE_NODE)
+DT_FOREACH_CHILD(DEBOUNCE_NODE, DEBOUNCE_CFG_CHECK)
+#endif
+
+/*
+ * Eager mode phases. Only the context that moves a button out of EAGER_IDLE reports it until
+ * the phase returns to idle, so the edge ISR and the work item never report concurrently.
+ */
+enum {
+	EAGER_IDLE,
+	/* Waiting glitch_us to confirm an edge. */
+	EAGER_CONFIRM,
+	/* Reported, ignoring edges until debounce_ms expires. */
+	EAGER_LOCKOUT,
+};
+
+/*
+ * Buttons filtered by the controller or not debounced at all are reported straight from the edge
+ * ISR, and resynced from the reconcile work. Whichever context finds the button idle reports it,
+ * and reads the pin again for every caller that arrived meanwhile, so the two never report
+ * concurrently.
+ */
+enum {
+	DIRECT_BUSY = BIT(0),
+	/* Another caller wants the pin read again. */
+	DIRECT_AGAIN = BIT(1),
+};
+
+struct button_gpio_data {
+	struct gpio_callback cb;
+	struct k_work_delayable debounce;
+	struct button_debounce state;
+	atomic_t eager_phase;
+	atomic_t direct;
+};
+
+static struct button_gpio_data data[BUTTON_COUNT];
+
+/* Buttons filtered by the controller, bit n for button n. Written by init only. */
+static uint32_t hw_debounced;
+
+/* Buttons on level interrupts, bit n for button n. Written by enable only. */
+static uint32_t level_irq;
+
+static void button_settle_handler(uint8_t idx, int level)
+{
+	BUTTON_TRACE_DEBOUNCE_SETTLE(idx, level);
+	button_core_report(idx, level);
+}
+
+/* One sample of a sampled algorithm; keeps sampling until the pin is stable again. */
+static void button_sample_handler(uint8_t idx, int level)
+{
+	const struct button_debounce_cfg *dcfg = &debounce_cfgs[idx];
+	struct button_gpio_data *d = &data[idx];
+	bool was = d->state.level;
+	struct button_cfg cfg;
+	bool more;
+
+	(void)button_cfg_get(idx, &cfg);
+	more = button_debounce_sample(dcfg, &d->state, level, cfg.debounce_ms);
+
+	if (d->state.level != was) {
+		BUTTON_TRACE_DEBOUNCE_SETTLE(idx, d->state.level);
+		button_core_report(idx, d->state.level);
+	}
+
+	if (more) {
+		k_work_schedule_for_queue(button_workq(), &d->debounce, K_MSEC(dcfg->period_ms));
+	}
+}
+
+static void button_eager_lockout(uint8_t idx, int level)
+{
+	struct button_gpio_data *d = &data[idx];
+	struct button_cfg cfg;
+
+	(void)button_cfg_get(idx, &cfg);
+	atomic_set(&d->eager_phase, EAGER_LOCKOUT);
+	k_work_schedule_for_queue(button_workq(), &d->debounce, K_MSEC(cfg.debounce_ms));
+
+	if (level != d->state.level) {
+		d->state.level = level;
+		BUTTON_TRACE_DEBOUNCE_SETTLE(idx, level);
+		button_core_report(idx, level);
+	}
+}
+
+/* From the edge ISR, or from the work item when an edge may have been ignored. */
+static void button_eager_start(uint8_t idx)
+{
+	const struct button_debounce_cfg *dcfg = &debounce_cfgs[idx];
+	struct button_gpio_data *d = &data[idx];
+	int level;
+
+	if (dcfg->glitch_us > 0) {
+		if (atomic_cas(&d->eager_phase, EAGER_IDLE, EAGER_CONFIRM)) {
+			k_work_schedule_for_queue(button_workq(), &d->debounce,
+						  K_USEC(dcfg->glitch_us));
+		}
+		return;
+	}
+
+	if (!atomic_cas(&d->eager_phase, EAGER_IDLE, EAGER_LOCKOUT)) {
+		return;
+	}
+
+	level = gpio_pin_get_dt(&buttons[idx]);
+	if (level < 0) {
+		atomic_set(&d->eager_phase, EAGER_IDLE);
+		return;
+	}
+
+	button_eager_lockout(idx, level);
+}
+
+/* End of a confirmation or lockout window. */
+static void button_eager_handler(uint8_t idx, int level)
+{
+	struct button_gpio_data *d = &data[idx];
+
+	/*
+	 * A confirmed edge is reported with a fresh lockout. After a lockout, a level that moved
+	 * behind it (e.g. a release shorter than the window) is an edge of its own.
+	 */
+	if (level != d->state.level) {
+		button_eager_lockout(idx, level);
+		return;
+	}
+
+	atomic_set(&d->eager_phase, EAGER_IDLE);
+
+	/* The ISR ignored edges up to the store above; catch one that changed the level. */
+	level = gpio_pin_get_dt(&buttons[idx]);
+	if (level >= 0 && level != d->state.level) {
+		button_eager_start(idx);
+	}
+}
+
+static void button_debounce_handler(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct button_gpio_data *d = CONTAINER_OF(dwork, struct button_gpio_data, debounce);
+	uint8_t idx = d - data;
+	int level = gpio_pin_get_dt(&buttons[idx]);
+
+	if (level < 0) {
+		LOG_ERR("Error %d: failed to read %s pin %d", level, buttons[idx].port->name,
+			buttons[idx].pin);
+		return;
+	}
+
+	switch (debounce_cfgs[idx].algo) {
+	case BUTTON_DEBOUNCE_SETTLE:
+		button_settle_handler(idx, level);
+		break;
+	case BUTTON_DEBOUNCE_EAGER:
+		button_eager_handler(idx, level);
+		break;
+	default:
+		button_sample_handler(idx, level);
+		break;
+	}
+}
+
+static void button_direct_report(uint8_t idx)
+{
+	struct button_gpio_data *d = &data[idx];
+	int level;
+
+	if (atomic_or(&d->direct, DIRECT_AGAIN) != 0) {
+		return;
+	}
+
+	do {
+		atomic_set(&d->direct, DIRECT_BUSY);
+		level = gpio_pin_get_dt(&buttons[idx]);
+		if (level >= 0) {
+			button_core_report(idx, level);
+		}
+	} while (!atomic_cas(&d->direct, DIRECT_BUSY, 0));
+}
+
+static void button_edge_process(uint8_t idx)
+{
+	struct button_gpio_data *d = &data[idx];
+	struct button_cfg cfg;
+
+	if ((hw_debounced & BIT(idx)) || debounce_cfgs[idx].algo == BUTTON_DEBOUNCE_NONE) {
+		/* Already filtered, or not to be: the level is final and no timer is involved. */
+		button_direct_report(idx);
+		return;
+	}
+
+	BUTTON_TRACE_DEBOUNCE_START(idx);
+	switch (debounce_cfgs[idx].algo) {
+	case BUTTON_DEBOUNCE_SETTLE:
+		/* Every edge restarts the settle window; the level is sampled once it expires. */
+		(void)button_cfg_get(idx, &cfg);
+		k_work_reschedule_for_queue(button_workq(), &d->debounce, K_MSEC(cfg.debounce_ms));
+		break;
+	case BUTTON_DEBOUNCE_EAGER:
+		button_eager_start(idx);
+		break;
+	default:
+		/* Starts sampling; edges while sampling is under way change nothing. */
+		k_work_schedule_for_queue(button_workq(), &d->debounce, K_NO_WAIT);
+		break;
+	}
+}
+
+/*
+ * Arms a level interrupt on the opposite of the current level. If the pin moves again before the
+ * interrupt is armed, it is pending as soon as it is, so a late ISR delays a transition but never
+ * loses it.
+ */
+static int button_level_arm(uint8_t idx)
+{
+	const struct gpio_dt_spec *button = &buttons[idx];
+	int level = gpio_pin_get_dt(button);
+
+	if (level < 0) {
+		return level;
+	}
+
+	return gpio_pin_interrupt_configure_dt(button, level ? GPIO_INT_LEVEL_INACTIVE
+							     : GPIO_INT_LEVEL_ACTIVE);
+}
+
+static void button_edge(const struct device *dev, struct gpio_callback *cb, uint32_t pins)
+{
+	struct button_gpio_data *d = CONTAINER_OF(cb, struct button_gpio_data, cb);
+	uint8_t idx = d - data;
+
+	BUTTON_TRACE_ISR_ENTER(idx);
+	if (level_irq & BIT(idx)) {
+		/* Flipping the level is what acknowledges the interrupt. */
+		(void)button_level_arm(idx);
+	}
+	button_edge_process(idx);
+	BUTTON_TRACE_ISR_EXIT(idx);
+}
+
+void button_backend_resync(uint8_t idx)
+{
+	button_edge_process(idx);
+}
+
+/*
+ * Requests the controller's debounce filter. Only a driver known to act on the flags, and that
+ * reports them back from gpio_pin_get_config(), is trusted with it; anything else returns
+ * -ENOTSUP so the button keeps its software debounce.
+ */
+static int button_hw_debounce_configure(uint8_t idx)
+{
+	const struct gpio_dt_spec *button = &buttons[idx];
+	gpio_flags_t flags;
+	int ret;
+
+	if (hw_debounce_ignored[idx]) {
+		return -ENOTSUP;
+	}
+
+	ret = gpio_pin_configure_dt(button, GPIO_INPUT | HW_DEBOUNCE_FLAGS);
+	if (ret != 0) {
+		return ret;
+	}
+
+	ret = gpio_pin_get_config_dt(button, &flags);
+	if (ret != 0 || (flags & HW_DEBOUNCE_FLAGS) != HW_DEBOUNCE_FLAGS) {
+		return -ENOTSUP;
+	}
+
+	return 0;
+}
+
+/*
+ * Requests the controller's input filter for a settle-timer button. Other algorithms were chosen
+ * explicitly for the button and stay in software.
+ */
+static int button_configure(uint8_t idx)
+{
+	const struct gpio_dt_spec *button = &buttons[idx];
+	int ret;
+
+	if (IS_ENABLED(CONFIG_BUTTON_HW_DEBOUNCE) &&
+	    debounce_cfgs[idx].algo == BUTTON_DEBOUNCE_SETTLE) {
+		ret = button_hw_debounce_configure(idx);
+		if (ret == 0) {
+			hw_debounced |= BIT(idx);
+			return 0;
+		}
+		if (ret != -ENOTSUP) {
+			return ret;
+		}
+		LOG_INF("%s pin %d has no hardware debounce, using software", button->port->name,
+			button->pin);
+	}
+
+	return gpio_pin_configure_dt(button, GPIO_INPUT);
+}
+
+enum button_debounce_mode button_backend_debounce_mode(uint8_t idx)
+{
+	if (debounce_cfgs[idx].algo == BUTTON_DEBOUNCE_NONE) {
+		return BUTTON_DEBOUNCE_MODE_NONE;
+	}
+
+	return (hw_debounced & BIT(idx)) ? BUTTON_DEBOUNCE_MODE_HARDWARE
+					 : BUTTON_DEBOUNCE_MODE_SOFTWARE;
+}
+
+int button_backend_init(void)
+{
+	int ret;
+
+	ARRAY_FOR_EACH(buttons, i) {
+		const struct gpio_dt_spec *button = &buttons[i];
+
+		if (!gpio_is_ready_dt(button)) {
+			LOG_ERR("Error: button device %s is not ready", button->port->name);
+			return -ENODEV;
+		}
+
+		ret = button_configure(i);
+		if (ret != 0) {
+			LOG_ERR("Error %d: failed to configure %s pin %d", ret, button->port->name,
+				button->pin);
+			return ret;
+		}
+
+		k_work_init_delayable(&data[i].debounce, button_debounce_handler);
+		if (debounce_cfgs[i].algo != BUTTON_DEBOUNCE_SETTLE) {
+			struct button_cfg cfg;
+
+			/* Eager only uses the level, as the last one it reported. */
+			(void)button_cfg_get(i, &cfg);
+			button_debounce_reset(&debounce_cfgs[i], &data[i].state,
+					      gpio_pin_get_dt(button) > 0, cfg.debounce_ms);
+		}
+	}
+
+	return 0;
+}
+
+int button_backend_get(uint8_t idx)
+{
+	return gpio_pin_get_dt(&buttons[idx]);
+}
+
+int button_backend_enable(void)
+{
+	int ret;
+
+	ARRAY_FOR_EACH(buttons, i) {
+		const struct gpio_dt_spec *button = &buttons[i];
+
+		/* Before arming: a level interrupt may be pending right away. */
+		gpio_init_callback(&data[i].cb, button_edge, BIT(button->pin));
+		gpio_add_callback(button->port, &data[i].cb);
+
+		ret = -ENOTSUP;
+		if (!IS_ENABLED(CONFIG_BUTTON_LEVEL_IRQ)) {
+			ret = gpio_pin_interrupt_configure_dt(button, GPIO_INT_EDGE_BOTH);
+			if (ret == -ENOTSUP) {
+				LOG_INF("%s pin %d has no both-edge interrupt, using level",
+					button->port->name, button->pin);
+			}
+		}
+
+		if (ret == -ENOTSUP) {
+			level_irq |= BIT(i);
+			ret = button_level_arm(i);
+		}
+
+		if (ret != 0) {
+			LOG_ERR("Error %d: failed to configure interrupt on %s pin %d", ret,
+				button->port->name, button->pin);
+			gpio_remove_callback(button->port, &data[i].cb);
+			return ret;
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,100 @@
+#include "button.h"
+#include "button_priv.h"
+#include "button_trace.h"
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/input/input.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_DECLARE(button, CONFIG_BUTTON_LOG_LEVEL);
+
+/*
+ * The gpio-keys input driver owns the pins and debounces them with the node's
+ * debounce-interval-ms; this backend only maps key codes back to button indexes.
+ */
+#define BUTTON_INPUT_CODE(node) DT_PROP(node, zephyr_code)
+#define BUTTON_GPIO_SPEC(node)  GPIO_DT_SPEC_GET(node, gpios)
+
+static const struct device *const keys_dev = DEVICE_DT_GET(BUTTON_NODE_LIST);
+
+static const uint16_t codes[] = {
+	DT_FOREACH_CHILD_STATUS_OKAY_SEP(BUTTON_NODE_LIST, BUTTON_INPUT_CODE, (,))};
+
+/* Only read to sample levels at init; the driver owns the pin configuration. */
+static const struct gpio_dt_spec buttons[] = {
+	DT_FOREACH_CHILD_STATUS_OKAY_SEP(BUTTON_NODE_LIST, BUTTON_GPIO_SPEC, (,))};
+
+static void button_input_cb(struct input_event *evt, void *user_data)
+{
+	if (evt->type != INPUT_EV_KEY) {
+		return;
+	}
+
+	ARRAY_FOR_EACH(codes, i) {
+		if (codes[i] == evt->code) {
+			BUTTON_TRACE_ISR_ENTER(i);
+			button_core_report(i, evt->value != 0);
+			BUTTON_TRACE_ISR_EXIT(i);
+			return;
+		}
+	}
+}
+
+INPUT_CALLBACK_DEFINE(keys_dev, button_input_cb, NULL);
+
+/* Runs on the system workqueue, where gpio-keys reports from in CONFIG_INPUT_MODE_SYNCHRONOUS. */
+static struct k_work resync_work[BUTTON_COUNT];
+
+static void button_input_resync_handler(struct k_work *work)
+{
+	uint8_t idx = work - resync_work;
+	int level = gpio_pin_get_dt(&buttons[idx]);
+
+	if (level >= 0) {
+		button_core_report(idx, level);
+	}
+}
+
+int button_backend_init(void)
+{
+	if (!device_is_ready(keys_dev)) {
+		LOG_ERR("Error: input device %s is not ready", keys_dev->name);
+		return -ENODEV;
+	}
+
+	ARRAY_FOR_EACH(resync_work, i) {
+		k_work_init(&resync_work[i], button_input_resync_handler);
+	}
+
+	return 0;
+}
+
+int button_backend_get(uint8_t idx)
+{
+	return gpio_pin_get_dt(&buttons[idx]);
+}
+
+/*
+ * The driver's own state cannot be corrected; report the pin to the core so the events at least
+ * agree. Nothing is injected into the input device, so other input listeners never see it. With
+ * asynchronous input the input thread may report the same button meanwhile; the core orders the
+ * two under the button's lock, and a stale level is caught by the next reconcile pass.
+ */
+void button_backend_resync(uint8_t idx)
+{
+	k_work_submit(&resync_work[idx]);
+}
+
+enum button_debounce_mode button_backend_debounce_mode(uint8_t idx)
+{
+	return BUTTON_DEBOUNCE_MODE_SOFTWARE;
+}
+
+int button_backend_enable(void)
+{
+	/* The gpio-keys driver enables its interrupts at boot. */
+	return 0;
+}
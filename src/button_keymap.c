@@ -0,0 +1,163 @@
+#include "button.h"
+#include "button_keymap.h"
+#include "button_obs.h"
+
+#include <dt-bindings/button/keymap.h>
+#include <zephyr/kernel.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/spinlock.h>
+
+#define KEYMAP_NODE   DT_COMPAT_GET_ANY_STATUS_OKAY(button_keymap)
+#define KEYMAP_LAYERS (DT_CHILD_NUM(KEYMAP_NODE) + 1)
+
+#define KEY_BUTTON(key) (((key) >> 24) & 0xff)
+#define KEY_EVT(key)    (((key) >> 16) & 0xff)
+#define KEY_ACTION(key) ((key) & 0xffff)
+
+#define ACTION_IS_LAYER(action) ((action) > BUTTON_ACTION_MAX)
+#define ACTION_IS_MO(action)    (((action) & 0xff00) == BUTTON_LAYER_MO(0))
+#define ACTION_LAYER(action)    ((action) & 0xff)
+
+BUILD_ASSERT(BUTTON_KEY_PRESSED == BUTTON_EVT_PRESSED &&
+		     BUTTON_KEY_RELEASED == BUTTON_EVT_RELEASED &&
+		     BUTTON_KEY_LONGPRESS == BUTTON_EVT_LONGPRESS &&
+		     BUTTON_KEY_REPEAT == BUTTON_EVT_REPEAT && BUTTON_KEY_HOLD == BUTTON_EVT_HOLD,
+	     "dt-bindings/button/keymap.h out of sync with enum button_evt_type");
+BUILD_ASSERT(KEYMAP_LAYERS <= 32, "layers are tracked in a 32-bit mask");
+
+/* An entry outside the table fails here as an initializer index out of bounds. */
+#define KEYMAP_ENTRY(node_id, prop, idx, layer)                                                    \
+	[layer][KEY_BUTTON(DT_PROP_BY_IDX(node_id, prop, idx))]                                    \
+	[KEY_EVT(DT_PROP_BY_IDX(node_id, prop, idx))] =                                            \
+		KEY_ACTION(DT_PROP_BY_IDX(node_id, prop, idx)),
+
+#define KEYMAP_LAYER(node_id)                                                                      \
+	DT_FOREACH_PROP_ELEM_VARGS(node_id, keymap, KEYMAP_ENTRY, DT_NODE_CHILD_IDX(node_id) + 1)
+
+static const uint16_t keymap[KEYMAP_LAYERS][BUTTON_COUNT][BUTTON_EVT_TYPE_COUNT] = {
+	DT_FOREACH_PROP_ELEM_VARGS(KEYMAP_NODE, keymap, KEYMAP_ENTRY, 0)
+	DT_FOREACH_CHILD(KEYMAP_NODE, KEYMAP_LAYER)};
+
+/* Guards the layer state below; events may come from more than one thread. */
+static struct k_spinlock lock;
+static uint32_t toggled;
+static uint32_t momentary;
+/* Momentary layers switched on by each button, cleared on its release. */
+static uint32_t held[BUTTON_COUNT];
+/* Layers active when each button was last pressed. */
+static uint32_t press_layers[BUTTON_COUNT];
+
+ZBUS_CHAN_DEFINE(chan_button_action, struct msg_button_action, NULL, NULL, ZBUS_OBSERVERS_EMPTY,
+		 ZBUS_MSG_INIT(.action = BUTTON_ACTION_NONE));
+
+static uint32_t keymap_active_layers(void)
+{
+	return BIT(0) | toggled | momentary;
+}
+
+/* Highest layer first; the common case is a hit on the first load. */
+static uint16_t keymap_resolve(uint32_t layers, uint8_t button, enum button_evt_type evt)
+{
+	while (layers != 0) {
+		uint32_t layer = find_msb_set(layers) - 1;
+		uint16_t action = keymap[layer][button][evt];
+
+		if (action != BUTTON_ACTION_NONE) {
+			return action;
+		}
+		layers &= ~BIT(layer);
+	}
+
+	return BUTTON_ACTION_NONE;
+}
+
+uint16_t button_keymap_lookup(uint8_t button, enum button_evt_type evt)
+{
+	k_spinlock_key_t key;
+	uint16_t action;
+
+	if (button >= BUTTON_COUNT || (unsigned int)evt >= BUTTON_EVT_TYPE_COUNT) {
+		return BUTTON_ACTION_NONE;
+	}
+
+	key = k_spin_lock(&lock);
+	action = keymap_resolve(keymap_active_layers(), button, evt);
+	k_spin_unlock(&lock, key);
+
+	return action;
+}
+
+uint32_t button_keymap_layers(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	uint32_t layers = keymap_active_layers();
+
+	k_spin_unlock(&lock, key);
+
+	return layers;
+}
+
+static void keymap_switch_layer(uint8_t button, uint16_t action)
+{
+	uint32_t layer = ACTION_LAYER(action);
+
+	if (layer >= KEYMAP_LAYERS) {
+		return;
+	}
+
+	if (ACTION_IS_MO(action)) {
+		held[button] |= BIT(layer);
+		momentary |= BIT(layer);
+	} else {
+		toggled ^= BIT(layer);
+	}
+}
+
+/* Another button may still hold the same layer, so rebuild the mask from what is left. */
+static void keymap_release_layers(uint8_t button)
+{
+	held[button] = 0;
+	momentary = 0;
+	for (size_t i = 0; i < BUTTON_COUNT; i++) {
+		momentary |= held[i];
+	}
+}
+
+static void keymap_listener_cb(const struct zbus_channel *chan)
+{
+	const struct msg_button_evt *msg = zbus_chan_const_msg(chan);
+	struct msg_button_action action;
+	k_spinlock_key_t key;
+
+	if ((msg->flags & BUTTON_EVT_FLAG_INITIAL) || msg->button >= BUTTON_COUNT ||
+	    (unsigned int)msg->evt >= BUTTON_EVT_TYPE_COUNT) {
+		return;
+	}
+
+	key = k_spin_lock(&lock);
+	if (msg->evt == BUTTON_EVT_PRESSED) {
+		press_layers[msg->button] = keymap_active_layers();
+	}
+	action.action = keymap_resolve(press_layers[msg->button] | BIT(0), msg->button, msg->evt);
+	if (msg->evt == BUTTON_EVT_RELEASED && held[msg->button] != 0) {
+		keymap_release_layers(msg->button);
+	}
+	if (ACTION_IS_LAYER(action.action)) {
+		keymap_switch_layer(msg->button, action.action);
+		action.action = BUTTON_ACTION_NONE;
+	}
+	k_spin_unlock(&lock, key);
+
+	if (action.action == BUTTON_ACTION_NONE) {
+		return;
+	}
+
+	action.button = msg->button;
+	action.evt = msg->evt;
+	action.timestamp = msg->timestamp;
+	(void)zbus_chan_pub(&chan_button_action, &action, K_NO_WAIT);
+}
+
+BUTTON_LISTENER_DEFINE(button_keymap_lis, keymap_listener_cb);
+
+ZBUS_CHAN_ADD_OBS(chan_button_evt, button_keymap_lis, 2);
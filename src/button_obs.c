@@ -0,0 +1,123 @@
+#include "button_obs.h"
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_DECLARE(button, CONFIG_BUTTON_LOG_LEVEL);
+
+ZBUS_CHAN_DEFINE(chan_button_obs_stats, struct button_obs_stats, NULL, NULL, ZBUS_OBSERVERS_EMPTY,
+		 ZBUS_MSG_INIT(0));
+
+ZBUS_CHAN_DECLARE(chan_button_evt);
+
+/* Only held to update or copy one timing entry. */
+static struct k_spinlock lock;
+
+/* Whole dispatches of the events published by the button core. */
+STRUCT_SECTION_ITERABLE(button_obs_timing, chan_button_evt_timing) = {
+	.name = "chan_button_evt",
+};
+
+static void button_obs_snapshot(const struct button_obs_timing *timing,
+				struct button_obs_stats *stats)
+{
+	stats->name = timing->name;
+	stats->calls = timing->calls;
+	stats->max_cycles = timing->max_cycles;
+	stats->avg_cycles = timing->calls ? timing->total_cycles / timing->calls : 0;
+	stats->over_budget = timing->over_budget;
+}
+
+static void button_obs_account(struct button_obs_timing *timing, uint32_t cycles,
+			       uint32_t budget_us)
+{
+	struct button_obs_stats stats;
+	k_spinlock_key_t key;
+	bool over = cycles > k_us_to_cyc_ceil32(budget_us);
+
+	key = k_spin_lock(&lock);
+	timing->calls++;
+	timing->total_cycles += cycles;
+	timing->max_cycles = MAX(timing->max_cycles, cycles);
+	timing->over_budget += over;
+	if (over) {
+		button_obs_snapshot(timing, &stats);
+		stats.last_cycles = cycles;
+	}
+	k_spin_unlock(&lock, key);
+
+	if (over) {
+		LOG_WRN("%s took %u us, budget %u us", timing->name,
+			k_cyc_to_us_floor32(cycles), budget_us);
+		/* Reported outside the timed region; nobody waits on a busy stats channel. */
+		(void)zbus_chan_pub(&chan_button_obs_stats, &stats, K_NO_WAIT);
+	}
+}
+
+void button_obs_run(struct button_obs_timing *timing, const struct zbus_channel *chan)
+{
+	uint32_t start = k_cycle_get_32();
+
+	timing->cb(chan);
+	button_obs_account(timing, k_cycle_get_32() - start, CONFIG_BUTTON_OBS_BUDGET_US);
+}
+
+int button_obs_evt_pub(const void *msg, k_timeout_t timeout)
+{
+	uint32_t start = k_cycle_get_32();
+	int ret;
+
+	ret = zbus_chan_pub(&chan_button_evt, msg, timeout);
+	if (ret == 0) {
+		button_obs_account(&chan_button_evt_timing, k_cycle_get_32() - start,
+				   CONFIG_BUTTON_OBS_CHAN_BUDGET_US);
+	}
+
+	return ret;
+}
+
+int button_obs_stats_get(const char *name, struct button_obs_stats *stats)
+{
+	STRUCT_SECTION_FOREACH(button_obs_timing, timing) {
+		if (strcmp(timing->name, name) == 0) {
+			k_spinlock_key_t key = k_spin_lock(&lock);
+
+			button_obs_snapshot(timing, stats);
+			stats->last_cycles = 0;
+			k_spin_unlock(&lock, key);
+
+			return 0;
+		}
+	}
+
+	return -ENOENT;
+}
+
+void button_obs_stats_foreach(button_obs_stats_cb_t cb, void *user_data)
+{
+	STRUCT_SECTION_FOREACH(button_obs_timing, timing) {
+		struct button_obs_stats stats = {0};
+		k_spinlock_key_t key = k_spin_lock(&lock);
+
+		button_obs_snapshot(timing, &stats);
+		k_spin_unlock(&lock, key);
+
+		cb(&stats, user_data);
+	}
+}
+
+void button_obs_stats_reset(void)
+{
+	STRUCT_SECTION_FOREACH(button_obs_timing, timing) {
+		k_spinlock_key_t key = k_spin_lock(&lock);
+
+		timing->calls = 0;
+		timing->total_cycles = 0;
+		timing->max_cycles = 0;
+		timing->over_budget = 0;
+		k_spin_unlock(&lock, key);
+	}
+}
@@ -0,0 +1,298 @@
+#include "button.h"
+#include "button_obs.h"
+#include "button_persist.h"
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/drivers/flash.h>
+#include <zephyr/fs/nvs.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_DECLARE(button, CONFIG_BUTTON_LOG_LEVEL);
+
+#define STORAGE_PARTITION storage_partition
+
+/* NVS ids: one record for all counters, then a ring of log records. */
+#define COUNTERS_ID 1
+#define LOG_ID_BASE 0x100
+
+/* A log record as written to flash; only the first count entries are valid. */
+struct log_record {
+	uint32_t seq;
+	uint16_t count;
+	struct button_log_entry entries[CONFIG_BUTTON_PERSIST_LOG_BATCH];
+} __packed;
+
+static struct nvs_fs fs;
+static bool mounted;
+
+/* Guards everything below; held only while copying, never across a flash write. */
+static struct k_spinlock lock;
+static struct button_persist_counters counters[BUTTON_COUNT];
+static struct log_record pending_log;
+static uint32_t pending_presses;
+static uint32_t next_log_seq;
+static uint32_t writes;
+static uint32_t log_dropped;
+
+static void flush_work_handler(struct k_work *work);
+
+static K_WORK_DEFINE(flush_work, flush_work_handler);
+static K_WORK_DELAYABLE_DEFINE(flush_timer, flush_work_handler);
+
+/* Serialises flushes from the work items and button_persist_flush(). */
+static K_MUTEX_DEFINE(flush_lock);
+
+static int persist_write(uint16_t id, const void *data, size_t len)
+{
+	ssize_t ret = nvs_write(&fs, id, data, len);
+
+	if (ret < 0) {
+		LOG_ERR("Error %d: failed to write record %u", (int)ret, id);
+		return ret;
+	}
+
+	/* NVS skips the write when the record already holds the same data. */
+	if (ret > 0) {
+		writes++;
+	}
+
+	return 0;
+}
+
+int button_persist_flush(void)
+{
+	static struct button_persist_counters counters_copy[BUTTON_COUNT];
+	static struct log_record log_copy;
+	k_spinlock_key_t key;
+	uint32_t presses;
+	int ret;
+
+	if (!mounted) {
+		return -ENODEV;
+	}
+
+	k_mutex_lock(&flush_lock, K_FOREVER);
+
+	/* Pending state is only cleared for what reached flash, so a failed write is retried. */
+	key = k_spin_lock(&lock);
+	memcpy(counters_copy, counters, sizeof(counters));
+	log_copy = pending_log;
+	presses = pending_presses;
+	k_spin_unlock(&lock, key);
+
+	if (presses == 0 && log_copy.count == 0) {
+		k_mutex_unlock(&flush_lock);
+		return 0;
+	}
+
+	(void)k_work_cancel_delayable(&flush_timer);
+
+	ret = persist_write(COUNTERS_ID, counters_copy, sizeof(counters_copy));
+	if (ret == 0 && log_copy.count > 0) {
+		log_copy.seq = next_log_seq;
+		ret = persist_write(LOG_ID_BASE + next_log_seq % CONFIG_BUTTON_PERSIST_LOG_RECORDS,
+				    &log_copy,
+				    offsetof(struct log_record, entries) +
+					    log_copy.count * sizeof(log_copy.entries[0]));
+		if (ret == 0) {
+			next_log_seq++;
+		}
+	}
+
+	if (ret == 0) {
+		/* Entries logged while writing stay pending for the next flush. */
+		key = k_spin_lock(&lock);
+		pending_presses -= presses;
+		pending_log.count -= log_copy.count;
+		memmove(pending_log.entries, &pending_log.entries[log_copy.count],
+			pending_log.count * sizeof(pending_log.entries[0]));
+		k_spin_unlock(&lock, key);
+	}
+
+	k_mutex_unlock(&flush_lock);
+
+	return ret;
+}
+
+static void flush_work_handler(struct k_work *work)
+{
+	(void)button_persist_flush();
+}
+
+static void persist_listener_cb(const struct zbus_channel *chan)
+{
+	const struct msg_button_evt *msg = zbus_chan_const_msg(chan);
+	k_spinlock_key_t key;
+	bool flush_now = false;
+
+	/* Initial events report the level at boot, not something the user did. */
+	if (!mounted || msg->button >= BUTTON_COUNT || (msg->flags & BUTTON_EVT_FLAG_INITIAL)) {
+		return;
+	}
+
+	key = k_spin_lock(&lock);
+	if (msg->evt == BUTTON_EVT_PRESSED) {
+		counters[msg->button].presses++;
+		pending_presses++;
+		flush_now = pending_presses >= CONFIG_BUTTON_PERSIST_FLUSH_PRESSES;
+	} else if (msg->evt == BUTTON_EVT_LONGPRESS) {
+		counters[msg->button].long_presses++;
+	}
+
+	/* RELEASED is implied by the next PRESSED; REPEAT and HOLD would flood the log. */
+	if (msg->evt == BUTTON_EVT_PRESSED || msg->evt == BUTTON_EVT_LONGPRESS) {
+		if (pending_log.count < CONFIG_BUTTON_PERSIST_LOG_BATCH) {
+			pending_log.entries[pending_log.count++] = (struct button_log_entry){
+				.uptime_s = k_uptime_seconds(),
+				.button = msg->button,
+				.evt = msg->evt,
+			};
+		} else {
+			/* Still full: flushing it keeps failing. */
+			log_dropped++;
+		}
+	}
+	flush_now |= pending_log.count == CONFIG_BUTTON_PERSIST_LOG_BATCH;
+	k_spin_unlock(&lock, key);
+
+	if (flush_now) {
+		k_work_submit(&flush_work);
+	} else if (CONFIG_BUTTON_PERSIST_FLUSH_INTERVAL_S > 0) {
+		/* Does nothing when already scheduled, so the deadline counts from the first event. */
+		k_work_schedule(&flush_timer, K_SECONDS(CONFIG_BUTTON_PERSIST_FLUSH_INTERVAL_S));
+	}
+}
+
+BUTTON_LISTENER_DEFINE(button_persist_lis, persist_listener_cb);
+
+ZBUS_CHAN_ADD_OBS(chan_button_evt, button_persist_lis, 1);
+
+static void persist_find_newest_log(void)
+{
+	struct log_record record;
+	bool found = false;
+
+	for (int i = 0; i < CONFIG_BUTTON_PERSIST_LOG_RECORDS; i++) {
+		ssize_t len = nvs_read(&fs, LOG_ID_BASE + i, &record, sizeof(record));
+
+		if (len < (ssize_t)offsetof(struct log_record, entries)) {
+			continue;
+		}
+		if (!found || (int32_t)(record.seq - next_log_seq) >= 0) {
+			next_log_seq = record.seq + 1;
+			found = true;
+		}
+	}
+}
+
+int button_persist_init(void)
+{
+	struct flash_pages_info info;
+	k_spinlock_key_t key;
+	ssize_t len;
+	int ret;
+
+	mounted = false;
+
+	fs.flash_device = FIXED_PARTITION_DEVICE(STORAGE_PARTITION);
+	if (!device_is_ready(fs.flash_device)) {
+		LOG_ERR("Error: flash device %s is not ready", fs.flash_device->name);
+		return -ENODEV;
+	}
+
+	fs.offset = FIXED_PARTITION_OFFSET(STORAGE_PARTITION);
+	ret = flash_get_page_info_by_offs(fs.flash_device, fs.offset, &info);
+	if (ret != 0) {
+		LOG_ERR("Error %d: failed to get flash page info", ret);
+		return ret;
+	}
+	fs.sector_size = info.size;
+	fs.sector_count = FIXED_PARTITION_SIZE(STORAGE_PARTITION) / info.size;
+
+	ret = nvs_mount(&fs);
+	if (ret != 0) {
+		LOG_ERR("Error %d: failed to mount NVS", ret);
+		return ret;
+	}
+
+	key = k_spin_lock(&lock);
+	memset(counters, 0, sizeof(counters));
+	pending_log.count = 0;
+	pending_presses = 0;
+	next_log_seq = 0;
+	writes = 0;
+	log_dropped = 0;
+	k_spin_unlock(&lock, key);
+
+	len = nvs_read(&fs, COUNTERS_ID, counters, sizeof(counters));
+	if (len > 0 && len != sizeof(counters)) {
+		/* Written by a build with a different button count; start over. */
+		LOG_WRN("Discarding %d bytes of counters", (int)len);
+		memset(counters, 0, sizeof(counters));
+	}
+
+	persist_find_newest_log();
+
+	mounted = true;
+
+	return 0;
+}
+
+int button_persist_counters_get(uint8_t idx, struct button_persist_counters *out)
+{
+	k_spinlock_key_t key;
+
+	if (idx >= BUTTON_COUNT || out == NULL) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&lock);
+	*out = counters[idx];
+	k_spin_unlock(&lock, key);
+
+	return 0;
+}
+
+int button_persist_log_foreach(button_log_cb_t cb, void *user_data)
+{
+	static struct log_record record;
+	uint32_t records = MIN(next_log_seq, CONFIG_BUTTON_PERSIST_LOG_RECORDS);
+
+	if (!mounted) {
+		return -ENODEV;
+	}
+
+	k_mutex_lock(&flush_lock, K_FOREVER);
+
+	for (uint32_t seq = next_log_seq - records; seq != next_log_seq; seq++) {
+		ssize_t len = nvs_read(&fs, LOG_ID_BASE + seq % CONFIG_BUTTON_PERSIST_LOG_RECORDS,
+				       &record, sizeof(record));
+
+		if (len < (ssize_t)offsetof(struct log_record, entries) || record.seq != seq) {
+			continue;
+		}
+
+		for (uint16_t i = 0; i < MIN(record.count, CONFIG_BUTTON_PERSIST_LOG_BATCH); i++) {
+			cb(&record.entries[i], user_data);
+		}
+	}
+
+	k_mutex_unlock(&flush_lock);
+
+	return 0;
+}
+
+uint32_t button_persist_write_count(void)
+{
+	return writes;
+}
+
+uint32_t button_persist_log_dropped(void)
+{
+	return log_dropped;
+}
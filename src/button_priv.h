@@ -0,0 +1,34 @@
+#ifndef _BUTTON_PRIV_H_
+#define _BUTTON_PRIV_H_
+#include <stdbool.h>
+#include <stdint.h>
+#include <zephyr/kernel.h>
+
+/*
+ * Interface between the button core (button.c) and the backend selected with
+ * CONFIG_BUTTON_BACKEND_*. A backend owns the hardware and debounce, and reports settled levels.
+ */
+
+/* Queue for all deferred button work: the module's own with CONFIG_BUTTON_WORKQ. */
+struct k_work_q *button_workq(void);
+
+int button_backend_init(void);
+int button_backend_enable(void);
+/* Current raw level of button idx: 1 pressed, 0 released, or a negative errno. */
+int button_backend_get(uint8_t idx);
+/*
+ * Run button idx through the debounce path as if an edge had been seen, so the backend reports
+ * its current level. Used when an edge was lost.
+ */
+void button_backend_resync(uint8_t idx);
+/* Valid once button_backend_init() returned. */
+enum button_debounce_mode button_backend_debounce_mode(uint8_t idx);
+
+/*
+ * Report the debounced level of button idx. Reports that do not change the level are ignored.
+ * Safe from any context and CPU, but a backend must not report the same button from two contexts
+ * concurrently, or the resulting events may be published out of order.
+ */
+void button_core_report(uint8_t idx, bool pressed);
+
+#endif /* _BUTTON_PRIV_H_ */
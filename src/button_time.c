@@ -0,0 +1,15 @@
+#include "button_time.h"
+
+#include <zephyr/kernel.h>
+
+/* Only built with CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME; set by button_time_init(). */
+struct button_cyc_conv button_cyc_to_us_conv;
+struct button_cyc_conv button_cyc_to_ms_conv;
+
+void button_time_init(void)
+{
+	uint32_t hz = sys_clock_hw_cycles_per_sec();
+
+	button_cyc_to_us_conv = (struct button_cyc_conv)BUTTON_CYC_CONV_INIT(USEC_PER_SEC, hz);
+	button_cyc_to_ms_conv = (struct button_cyc_conv)BUTTON_CYC_CONV_INIT(MSEC_PER_SEC, hz);
+}
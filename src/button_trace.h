@@ -0,0 +1,33 @@
+#ifndef _BUTTON_TRACE_H_
+#define _BUTTON_TRACE_H_
+
+/*
+ * Tracepoints along the button pipeline, emitted as CTF named events so they show up next to the
+ * kernel's ISR and thread events in Trace Compass. Event names are limited to 20 characters by
+ * the CTF named_event record. Without CONFIG_BUTTON_TRACING every hook expands to nothing.
+ */
+
+#ifdef CONFIG_BUTTON_TRACING
+#include <zephyr/tracing/tracing.h>
+
+#define BUTTON_TRACE(name, arg0, arg1)                                                             \
+	sys_trace_named_event(name, (uint32_t)(arg0), (uint32_t)(arg1))
+#else
+#define BUTTON_TRACE(name, arg0, arg1)                                                             \
+	do {                                                                                       \
+	} while (0)
+#endif
+
+/* Backend edge handler (GPIO callback or input event callback). */
+#define BUTTON_TRACE_ISR_ENTER(idx)             BUTTON_TRACE("btn_isr_enter", idx, 0)
+#define BUTTON_TRACE_ISR_EXIT(idx)              BUTTON_TRACE("btn_isr_exit", idx, 0)
+/* Software debounce window (re)started and settled on a level. */
+#define BUTTON_TRACE_DEBOUNCE_START(idx)        BUTTON_TRACE("btn_debounce_start", idx, 0)
+#define BUTTON_TRACE_DEBOUNCE_SETTLE(idx, lvl)  BUTTON_TRACE("btn_debounce_settle", idx, lvl)
+/* Core recognised a timed gesture (long press, repeat, hold level) for a button. */
+#define BUTTON_TRACE_GESTURE(idx, evt)          BUTTON_TRACE("btn_gesture", idx, evt)
+/* zbus_chan_pub() on chan_button_evt; the span covers every listener. */
+#define BUTTON_TRACE_PUBLISH_ENTER(idx, evt)    BUTTON_TRACE("btn_pub_enter", idx, evt)
+#define BUTTON_TRACE_PUBLISH_EXIT(idx, ret)     BUTTON_TRACE("btn_pub_exit", idx, ret)
+
+#endif /* _BUTTON_TRACE_H_ */
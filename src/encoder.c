@@ -0,0 +1,216 @@
+#include "encoder.h"
+#include "button_priv.h"
+#include "button_time.h"
+
+#include <errno.h>
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_DECLARE(button, CONFIG_BUTTON_LOG_LEVEL);
+
+/*
+ * Quadrature decoder for the gpio-qdec node with the qdec0 alias. Both phase interrupts feed a
+ * table-driven state machine; steps-per-period transitions make one detent. Detents accumulate
+ * in the ISR and a work item on the button workqueue publishes them, at most once every
+ * CONFIG_ENCODER_PUBLISH_INTERVAL_MS. The first detent after a quiet interval goes out at once;
+ * only the ones following it wait for the interval to end.
+ */
+
+#define QDEC_NODE        DT_ALIAS(qdec0)
+#define STEPS_PER_DETENT DT_PROP(QDEC_NODE, steps_per_period)
+#define IDLE_TIMEOUT_MS  DT_PROP(QDEC_NODE, idle_timeout_ms)
+
+ZBUS_CHAN_DEFINE(chan_encoder_evt, struct msg_encoder_evt, NULL, NULL, ZBUS_OBSERVERS_EMPTY,
+		 ZBUS_MSG_INIT(0));
+
+static const struct gpio_dt_spec phases[] = {
+	GPIO_DT_SPEC_GET_BY_IDX(QDEC_NODE, gpios, 0),
+	GPIO_DT_SPEC_GET_BY_IDX(QDEC_NODE, gpios, 1),
+};
+
+/*
+ * Step for each (previous << 2 | current) phase state, with state = A << 1 | B. Clockwise is
+ * 00 -> 10 -> 11 -> 01. Transitions where both phases changed are invalid and count as 0.
+ */
+static const int8_t qdec_table[16] = {
+	0, -1, 1, 0, 1, 0, 0, -1, -1, 0, 0, 1, 0, 1, -1, 0,
+};
+
+static struct gpio_callback phase_cb[ARRAY_SIZE(phases)];
+static struct k_work_delayable publish_work;
+static atomic_t initialized;
+static atomic_t invalid;
+
+/* Decoder state, shared between the phase ISRs and the publish work item. */
+static struct k_spinlock lock;
+static uint8_t state;
+static int8_t steps;
+static int32_t pending;
+static uint32_t last_detent_at;
+static uint32_t first_detent_at;
+/* When publish_work last ran, which starts the next rate limiting interval. */
+static uint32_t last_run_at;
+
+/* Publish work only. */
+static uint32_t last_publish_at;
+
+static int encoder_read_state(void)
+{
+	int a = gpio_pin_get_dt(&phases[0]);
+	int b = gpio_pin_get_dt(&phases[1]);
+
+	if (a < 0 || b < 0) {
+		return a < 0 ? a : b;
+	}
+
+	return (a << 1) | b;
+}
+
+static void encoder_publish_handler(struct k_work *work)
+{
+	struct msg_encoder_evt msg;
+	k_spinlock_key_t key;
+	uint32_t elapsed_us;
+	uint32_t ref;
+	int32_t detents;
+
+	key = k_spin_lock(&lock);
+	detents = pending;
+	pending = 0;
+	last_run_at = k_cycle_get_32();
+	msg.timestamp = last_detent_at;
+	/* Speed over the gap since the previous event, or over this burst after an idle period. */
+	ref = button_cyc_to_ms(first_detent_at - last_publish_at) < IDLE_TIMEOUT_MS
+		      ? last_publish_at
+		      : first_detent_at;
+	k_spin_unlock(&lock, key);
+
+	if (detents == 0) {
+		return;
+	}
+
+	elapsed_us = MAX(button_cyc_to_us(msg.timestamp - ref),
+			 CONFIG_ENCODER_PUBLISH_INTERVAL_MS * USEC_PER_MSEC);
+	msg.detents = CLAMP(detents, INT16_MIN, INT16_MAX);
+	msg.velocity = CLAMP((int64_t)detents * USEC_PER_SEC / elapsed_us, INT16_MIN, INT16_MAX);
+	last_publish_at = msg.timestamp;
+
+	zbus_chan_pub(&chan_encoder_evt, &msg, K_NO_WAIT);
+}
+
+static void encoder_phase_edge(const struct device *dev, struct gpio_callback *cb, uint32_t pins)
+{
+	uint32_t now = k_cycle_get_32();
+	k_spinlock_key_t key;
+	uint32_t since_run_ms = 0;
+	int8_t step;
+	int cur;
+	bool detent = false;
+
+	cur = encoder_read_state();
+	if (cur < 0) {
+		return;
+	}
+
+	key = k_spin_lock(&lock);
+	step = qdec_table[(state << 2) | cur];
+	if (step == 0 && cur != state) {
+		atomic_inc(&invalid);
+	}
+	state = cur;
+	steps += step;
+	if (steps >= STEPS_PER_DETENT || steps <= -STEPS_PER_DETENT) {
+		if (pending == 0) {
+			first_detent_at = now;
+		}
+		pending += steps / STEPS_PER_DETENT;
+		steps %= STEPS_PER_DETENT;
+		last_detent_at = now;
+		detent = true;
+		since_run_ms = button_cyc_to_ms(now - last_run_at);
+	}
+	k_spin_unlock(&lock, key);
+
+	if (detent) {
+		/* No-op while an event is already due, which is what coalesces fast spins. */
+		k_work_schedule_for_queue(
+			button_workq(), &publish_work,
+			since_run_ms >= CONFIG_ENCODER_PUBLISH_INTERVAL_MS
+				? K_NO_WAIT
+				: K_MSEC(CONFIG_ENCODER_PUBLISH_INTERVAL_MS - since_run_ms));
+	}
+}
+
+static void encoder_unwind(void)
+{
+	ARRAY_FOR_EACH(phases, i) {
+		(void)gpio_pin_interrupt_configure_dt(&phases[i], GPIO_INT_DISABLE);
+		(void)gpio_remove_callback(phases[i].port, &phase_cb[i]);
+	}
+	atomic_clear(&initialized);
+}
+
+int encoder_init(void)
+{
+	int ret;
+
+	if (!atomic_cas(&initialized, 0, 1)) {
+		return 0;
+	}
+
+	k_work_init_delayable(&publish_work, encoder_publish_handler);
+	/* Nothing was published yet, so the first detent goes out at once. */
+	last_run_at = k_cycle_get_32() - k_ms_to_cyc_ceil32(CONFIG_ENCODER_PUBLISH_INTERVAL_MS);
+
+	ARRAY_FOR_EACH(phases, i) {
+		const struct gpio_dt_spec *phase = &phases[i];
+
+		if (!gpio_is_ready_dt(phase)) {
+			LOG_ERR("Error: encoder device %s is not ready", phase->port->name);
+			atomic_clear(&initialized);
+			return -ENODEV;
+		}
+
+		ret = gpio_pin_configure_dt(phase, GPIO_INPUT);
+		if (ret != 0) {
+			LOG_ERR("Error %d: failed to configure %s pin %d", ret, phase->port->name,
+				phase->pin);
+			atomic_clear(&initialized);
+			return ret;
+		}
+	}
+
+	ret = encoder_read_state();
+	if (ret < 0) {
+		atomic_clear(&initialized);
+		return ret;
+	}
+	state = ret;
+
+	ARRAY_FOR_EACH(phases, i) {
+		const struct gpio_dt_spec *phase = &phases[i];
+
+		gpio_init_callback(&phase_cb[i], encoder_phase_edge, BIT(phase->pin));
+		gpio_add_callback(phase->port, &phase_cb[i]);
+
+		ret = gpio_pin_interrupt_configure_dt(phase, GPIO_INT_EDGE_BOTH);
+		if (ret != 0) {
+			LOG_ERR("Error %d: failed to configure interrupt on %s pin %d", ret,
+				phase->port->name, phase->pin);
+			encoder_unwind();
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+uint32_t encoder_invalid_transitions(void)
+{
+	return atomic_get(&invalid);
+}
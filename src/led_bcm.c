@@ -0,0 +1,202 @@
+#include "led_bcm.h"
+
+#include <errno.h>
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_DECLARE(button, CONFIG_BUTTON_LOG_LEVEL);
+
+/*
+ * Binary code modulation for the gpio-leds LEDs. A frame shows one bit plane per brightness bit,
+ * bit n for CONFIG_LED_BCM_BIT0_US << n, so a frame lasts LED_BCM_LEVELS - 1 times the shortest
+ * plane and a brightness b keeps its LED on for b of those. One timer steps through the planes,
+ * and each plane is a single masked write per GPIO port. While no LED is dimmed, the pins are
+ * written once and the timer stops.
+ */
+
+#define BITS CONFIG_LED_BCM_BITS
+
+BUILD_ASSERT(LED_COUNT <= 32, "dimmed LEDs are tracked in a 32-bit mask");
+BUILD_ASSERT((CONFIG_LED_BCM_BIT0_US * CONFIG_SYS_CLOCK_TICKS_PER_SEC) % USEC_PER_SEC == 0,
+	     "LED_BCM_BIT0_US must be a multiple of the system tick, or planes round unevenly");
+
+#define LED_GPIO_SPEC(node) GPIO_DT_SPEC_GET(node, gpios)
+
+static const struct gpio_dt_spec leds[] = {
+	DT_FOREACH_CHILD_STATUS_OKAY_SEP(LED_NODE_LIST, LED_GPIO_SPEC, (,))};
+
+struct bcm_port {
+	const struct device *dev;
+	gpio_port_pins_t mask;
+	/* Raw pin values for each bit plane, active-low LEDs already inverted. */
+	gpio_port_value_t planes[BITS];
+};
+
+static struct k_timer frame_timer;
+/* Claimed by the first led_bcm_init(); ready once the ports are built. */
+static atomic_t initialized;
+static atomic_t ready;
+static atomic_t wakeups;
+
+/* Written by init only. */
+static struct bcm_port ports[LED_COUNT];
+static uint8_t port_count;
+static uint8_t led_port[LED_COUNT];
+
+/* Frame state, shared between led_bcm_set() and the timer. */
+static struct k_spinlock lock;
+static uint8_t levels[LED_COUNT];
+/* LEDs neither off nor fully on, bit n for LED n. */
+static uint32_t dimmed;
+static uint8_t plane;
+/* End of the plane being shown, absolute so rounding to ticks does not add up over a frame. */
+static int64_t plane_end;
+
+static void bcm_write_plane(uint8_t bit)
+{
+	for (uint8_t p = 0; p < port_count; p++) {
+		(void)gpio_port_set_masked_raw(ports[p].dev, ports[p].mask, ports[p].planes[bit]);
+	}
+}
+
+static void bcm_timer_handler(struct k_timer *timer)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	uint8_t bit = plane;
+
+	atomic_inc(&wakeups);
+
+	/* The last dimmed LED may have been set while this expiry was pending. */
+	if (dimmed == 0) {
+		k_spin_unlock(&lock, key);
+		return;
+	}
+
+	bcm_write_plane(bit);
+	plane = (bit + 1) % BITS;
+	plane_end += k_us_to_ticks_ceil64((uint64_t)CONFIG_LED_BCM_BIT0_US << bit);
+	k_timer_start(timer, K_TIMEOUT_ABS_TICKS(plane_end), K_NO_WAIT);
+
+	k_spin_unlock(&lock, key);
+}
+
+/* Rebuilds the planes of port p from the LED levels. Called with the lock held. */
+static void bcm_update_port(uint8_t p)
+{
+	struct bcm_port *port = &ports[p];
+
+	for (uint8_t bit = 0; bit < BITS; bit++) {
+		gpio_port_value_t value = 0;
+
+		ARRAY_FOR_EACH(leds, i) {
+			bool on = (levels[i] >> bit) & 1;
+
+			if (led_port[i] != p) {
+				continue;
+			}
+			if (on != ((leds[i].dt_flags & GPIO_ACTIVE_LOW) != 0)) {
+				value |= BIT(leds[i].pin);
+			}
+		}
+		port->planes[bit] = value;
+	}
+}
+
+int led_bcm_set(uint8_t led, uint8_t brightness)
+{
+	k_spinlock_key_t key;
+	uint32_t was;
+
+	if (led >= LED_COUNT || brightness >= LED_BCM_LEVELS) {
+		return -EINVAL;
+	}
+
+	if (!atomic_get(&ready)) {
+		return -ENODEV;
+	}
+
+	key = k_spin_lock(&lock);
+
+	levels[led] = brightness;
+	bcm_update_port(led_port[led]);
+
+	was = dimmed;
+	WRITE_BIT(dimmed, led, brightness != 0 && brightness != LED_BCM_LEVELS - 1);
+
+	if (dimmed == 0) {
+		/* Every plane is the same: write it once and let the CPU sleep. */
+		k_timer_stop(&frame_timer);
+		bcm_write_plane(0);
+	} else if (was == 0) {
+		plane = 0;
+		plane_end = k_uptime_ticks();
+		k_timer_start(&frame_timer, K_NO_WAIT, K_NO_WAIT);
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return 0;
+}
+
+int led_bcm_init(void)
+{
+	int ret;
+
+	if (!atomic_cas(&initialized, 0, 1)) {
+		return 0;
+	}
+
+	k_timer_init(&frame_timer, bcm_timer_handler, NULL);
+
+	ARRAY_FOR_EACH(leds, i) {
+		const struct gpio_dt_spec *led = &leds[i];
+		uint8_t p;
+
+		if (!gpio_is_ready_dt(led)) {
+			LOG_ERR("Error: LED device %s is not ready", led->port->name);
+			atomic_clear(&initialized);
+			return -ENODEV;
+		}
+
+		ret = gpio_pin_configure_dt(led, GPIO_OUTPUT_INACTIVE);
+		if (ret != 0) {
+			LOG_ERR("Error %d: failed to configure %s pin %d", ret, led->port->name,
+				led->pin);
+			atomic_clear(&initialized);
+			return ret;
+		}
+
+		for (p = 0; p < port_count && ports[p].dev != led->port; p++) {
+		}
+		if (p == port_count) {
+			ports[port_count++].dev = led->port;
+		}
+		ports[p].mask |= BIT(led->pin);
+		led_port[i] = p;
+	}
+
+	for (uint8_t p = 0; p < port_count; p++) {
+		bcm_update_port(p);
+	}
+
+	atomic_set(&ready, 1);
+
+	return 0;
+}
+
+static int led_bcm_sys_init(void)
+{
+	return led_bcm_init();
+}
+
+SYS_INIT(led_bcm_sys_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
+
+uint32_t led_bcm_wakeups(void)
+{
+	return atomic_get(&wakeups);
+}
@@ -13,5 +13,9 @@ int main(void)
 
 	button_init();
 
+	if (button_boot_combo(BIT(0))) {
+		printf("Button 0 held at boot\n");
+	}
+
 	return 0;
 }
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2025 Rodrigo Peixoto <rodrigopex@ic.ufal.br>
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/drivers/adc/adc_emul.h>
+
+#include "button.h"
+
+ZBUS_MSG_SUBSCRIBER_DEFINE(msub_button_evt);
+
+ZBUS_CHAN_ADD_OBS(chan_button_evt, msub_button_evt, 3);
+
+static const struct device *const adc_dev = DEVICE_DT_GET(DT_NODELABEL(adc0));
+
+#define KEYUP_MV 3300
+
+/* Idle sampling period plus debounce, with margin. */
+#define SETTLE_MS (CONFIG_BUTTON_ADC_IDLE_PERIOD_MS + CONFIG_BUTTON_DEBOUNCE_MS + 30)
+
+#define LADDER_SET(_mv)                                                                            \
+	do {                                                                                       \
+		zassert_ok(adc_emul_const_value_set(adc_dev, 0, _mv));                             \
+		k_msleep(SETTLE_MS);                                                               \
+	} while (0)
+
+static void expect_evt(uint8_t button, enum button_evt_type evt)
+{
+	const struct zbus_channel *chan;
+	struct msg_button_evt msg = {.evt = BUTTON_EVT_UNDEFINED};
+
+	zassert_ok(zbus_sub_wait_msg(&msub_button_evt, &chan, &msg, K_SECONDS(1)));
+	zassert_equal(msg.button, button);
+	zassert_equal(msg.evt, evt);
+}
+
+static void expect_no_evt(void)
+{
+	const struct zbus_channel *chan;
+	struct msg_button_evt msg;
+
+	zassert_equal(zbus_sub_wait_msg(&msub_button_evt, &chan, &msg, K_MSEC(100)), -ENOMSG);
+}
+
+static void *adc_ladder_setup(void)
+{
+	zassert_true(device_is_ready(adc_dev));
+
+	LADDER_SET(KEYUP_MV);
+
+	return NULL;
+}
+
+static void adc_ladder_before(void *f)
+{
+	const struct zbus_channel *chan;
+	struct msg_button_evt msg;
+
+	LADDER_SET(KEYUP_MV);
+	while (zbus_sub_wait_msg(&msub_button_evt, &chan, &msg, K_NO_WAIT) == 0) {
+	}
+}
+
+ZTEST(adc_ladder, test_01_single_button)
+{
+	/* Nearest threshold wins, 2150 mV is button 2. */
+	LADDER_SET(2150);
+	expect_evt(2, BUTTON_EVT_PRESSED);
+
+	LADDER_SET(KEYUP_MV);
+	expect_evt(2, BUTTON_EVT_RELEASED);
+}
+
+ZTEST(adc_ladder, test_02_shared_threshold_is_a_combo)
+{
+	LADDER_SET(1500);
+	expect_evt(0, BUTTON_EVT_PRESSED);
+	expect_evt(1, BUTTON_EVT_PRESSED);
+
+	/* Letting go of button 0 first. */
+	LADDER_SET(800);
+	expect_evt(0, BUTTON_EVT_RELEASED);
+
+	LADDER_SET(KEYUP_MV);
+	expect_evt(1, BUTTON_EVT_RELEASED);
+}
+
+ZTEST(adc_ladder, test_03_glitch_shorter_than_debounce)
+{
+	zassert_ok(adc_emul_const_value_set(adc_dev, 0, 0));
+	k_msleep(CONFIG_BUTTON_DEBOUNCE_MS / 2);
+	zassert_ok(adc_emul_const_value_set(adc_dev, 0, KEYUP_MV));
+
+	k_msleep(SETTLE_MS);
+	expect_no_evt();
+}
+
+ZTEST_SUITE(adc_ladder, NULL, adc_ladder_setup, adc_ladder_before, NULL, NULL);
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2025 Rodrigo Peixoto <rodrigopex@ic.ufal.br>
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/drivers/gpio/gpio_emul.h>
+
+#include "button.h"
+
+/*
+ * Compares the backends selected by CONFIG_BUTTON_BACKEND_*: latency from the emulated edge to
+ * the zbus listener, and CPU cycles spent by all non-idle threads (ISRs included) per event.
+ */
+
+#define ITERATIONS 50
+#define SETTLE_MS  (DT_PROP(BUTTON_NODE_LIST, debounce_interval_ms) + 20)
+
+static const struct gpio_dt_spec button_gpio = GPIO_DT_SPEC_GET(DT_ALIAS(sw0), gpios);
+
+static volatile uint32_t received_at;
+
+static void bench_listener_cb(const struct zbus_channel *chan)
+{
+	received_at = k_cycle_get_32();
+}
+
+ZBUS_LISTENER_DEFINE(bench_lis, bench_listener_cb);
+
+ZBUS_CHAN_ADD_OBS(chan_button_evt, bench_lis, 3);
+
+static void busy_cycles_cb(const struct k_thread *thread, void *user_data)
+{
+	const char *name = k_thread_name_get((k_tid_t)thread);
+	k_thread_runtime_stats_t stats;
+
+	if (name != NULL && strncmp(name, "idle", 4) == 0) {
+		return;
+	}
+
+	if (k_thread_runtime_stats_get((k_tid_t)thread, &stats) == 0) {
+		*(uint64_t *)user_data += stats.execution_cycles;
+	}
+}
+
+static uint64_t busy_cycles(void)
+{
+	uint64_t total = 0;
+
+	k_thread_foreach_unlocked(busy_cycles_cb, &total);
+
+	return total;
+}
+
+static void *backend_setup(void)
+{
+	button_init();
+
+	gpio_emul_input_set(button_gpio.port, button_gpio.pin, 1);
+
+	button_enable_interrupts();
+
+	k_msleep(SETTLE_MS);
+
+	return NULL;
+}
+
+ZTEST(backend, test_edge_to_listener)
+{
+	uint32_t lat_min = UINT32_MAX;
+	uint32_t lat_max = 0;
+	uint64_t lat_sum = 0;
+	uint64_t busy_start;
+	uint64_t busy;
+
+	busy_start = busy_cycles();
+
+	for (int i = 0; i < ITERATIONS * 2; i++) {
+		uint32_t start;
+		uint32_t lat;
+
+		received_at = 0;
+		start = k_cycle_get_32();
+		gpio_emul_input_set(button_gpio.port, button_gpio.pin, i & 1);
+		k_msleep(SETTLE_MS);
+
+		zassert_not_equal(received_at, 0, "no event for edge %d", i);
+
+		lat = received_at - start;
+		lat_min = MIN(lat_min, lat);
+		lat_max = MAX(lat_max, lat);
+		lat_sum += lat;
+	}
+
+	busy = busy_cycles() - busy_start;
+
+	TC_PRINT("backend: %s\n", IS_ENABLED(CONFIG_BUTTON_BACKEND_INPUT) ? "input" : "gpio");
+	TC_PRINT("latency us: min %u avg %u max %u\n", k_cyc_to_us_floor32(lat_min),
+		 k_cyc_to_us_floor32(lat_sum / (ITERATIONS * 2)), k_cyc_to_us_floor32(lat_max));
+	TC_PRINT("busy cycles per event: %llu\n", busy / (ITERATIONS * 2));
+}
+
+ZTEST_SUITE(backend, NULL, backend_setup, NULL, NULL, NULL);
@@ -0,0 +1,289 @@
+/*
+ * Copyright (c) 2025 Rodrigo Peixoto <rodrigopex@ic.ufal.br>
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stdlib.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/drivers/gpio/gpio_emul.h>
+
+#include "button.h"
+
+/*
+ * Contention on chan_button_evt over a fixed run:
+ *
+ * - an edge generator at the highest priority toggles the eager button's gpio-emul pin, so every
+ *   edge goes through the GPIO callback, the eager debounce and the core's publish;
+ * - SUBSCRIBERS subscriber threads of decreasing priority observe both chan_button_evt and an
+ *   LED command channel, so their queues are shared between the two;
+ * - LISTENERS listeners run inside every publish;
+ * - LED_PUBLISHERS mid-priority threads publish LED commands;
+ * - a lowest-priority thread periodically claims chan_button_evt, holding its lock.
+ *
+ * Reported: edge-to-published latency percentiles, events the core dropped because the channel
+ * was busy, notifications each subscriber missed, and priority inversion incidents. The first
+ * subscriber, which only the generator outranks, checks every read that blocked behind the
+ * claiming thread: when the threads other than the lock holder and the generator ran longer
+ * during the wait than the holder did, middle priorities kept the holder off the CPU.
+ */
+
+#define RUN_MS          2000
+#define SUBSCRIBERS     4
+#define LISTENERS       3
+#define LED_PUBLISHERS  2
+/* Longer than the eager lockout, so every edge is published as it happens. */
+#define GEN_PERIOD_US   (2 * DT_PROP(BUTTON_NODE_LIST, debounce_interval_ms) * USEC_PER_MSEC)
+#define LED_PERIOD_US   300
+#define CLAIM_HOLD_US   200
+#define MAX_SAMPLES     8192
+#define STACK_SIZE      1024
+
+struct msg_led_cmd {
+	uint8_t led;
+	uint8_t level;
+};
+
+ZBUS_CHAN_DEFINE(chan_led_cmd, struct msg_led_cmd, NULL, NULL, ZBUS_OBSERVERS_EMPTY,
+		 ZBUS_MSG_INIT(0));
+
+static const struct gpio_dt_spec button = GPIO_DT_SPEC_GET(DT_ALIAS(sw0), gpios);
+
+static volatile bool running;
+
+/* Generator only. */
+static uint32_t samples[MAX_SAMPLES];
+static uint32_t sample_count;
+static uint32_t edges;
+
+static atomic_t led_failed;
+static atomic_t listener_calls[LISTENERS];
+
+/* Set while the claiming thread holds chan_button_evt. */
+static atomic_t claim_held;
+/* First subscriber only. */
+static uint32_t blocked_reads;
+static uint32_t inversions;
+
+struct sub_stats {
+	uint32_t received;
+};
+
+static struct sub_stats sub_stats[SUBSCRIBERS];
+
+#define SUB_DEFINE(i, _)                                                                           \
+	ZBUS_SUBSCRIBER_DEFINE(sub##i, 4);                                                         \
+	ZBUS_CHAN_ADD_OBS(chan_button_evt, sub##i, 4);                                             \
+	ZBUS_CHAN_ADD_OBS(chan_led_cmd, sub##i, 4);
+LISTIFY(SUBSCRIBERS, SUB_DEFINE, ())
+
+#define SUB_REF(i, _) &sub##i
+static const struct zbus_observer *const subs[] = {LISTIFY(SUBSCRIBERS, SUB_REF, (,))};
+
+#define LIS_DEFINE(i, _)                                                                           \
+	static void lis##i##_cb(const struct zbus_channel *chan)                                   \
+	{                                                                                          \
+		atomic_inc(&listener_calls[i]);                                                    \
+		k_busy_wait(5);                                                                    \
+	}                                                                                          \
+	ZBUS_LISTENER_DEFINE(lis##i, lis##i##_cb);                                                 \
+	ZBUS_CHAN_ADD_OBS(chan_button_evt, lis##i, 5);
+LISTIFY(LISTENERS, LIS_DEFINE, ())
+
+static K_THREAD_STACK_ARRAY_DEFINE(sub_stacks, SUBSCRIBERS, STACK_SIZE);
+static struct k_thread sub_threads[SUBSCRIBERS];
+static K_THREAD_STACK_ARRAY_DEFINE(led_stacks, LED_PUBLISHERS, STACK_SIZE);
+static struct k_thread led_threads[LED_PUBLISHERS];
+static K_THREAD_STACK_DEFINE(gen_stack, STACK_SIZE);
+static struct k_thread gen_thread;
+static K_THREAD_STACK_DEFINE(claim_stack, STACK_SIZE);
+static struct k_thread claim_thread;
+
+static uint64_t runtime_cycles(struct k_thread *thread)
+{
+	k_thread_runtime_stats_t stats;
+
+	(void)k_thread_runtime_stats_get(thread, &stats);
+
+	return stats.execution_cycles;
+}
+
+/* Reads chan_button_evt and, if the claiming thread held it, checks what ran meanwhile. */
+static void read_watching_holder(struct msg_button_evt *msg)
+{
+	bool held = atomic_get(&claim_held);
+	uint64_t holder_ran = runtime_cycles(&claim_thread);
+	uint64_t gen_ran = runtime_cycles(&gen_thread);
+	uint32_t start = k_cycle_get_32();
+	int64_t others_ran;
+	uint32_t waited;
+
+	if (zbus_chan_read(&chan_button_evt, msg, K_MSEC(10)) != 0) {
+		return;
+	}
+	waited = k_cycle_get_32() - start;
+	holder_ran = runtime_cycles(&claim_thread) - holder_ran;
+	gen_ran = runtime_cycles(&gen_thread) - gen_ran;
+
+	if (!held) {
+		return;
+	}
+
+	blocked_reads++;
+	others_ran = (int64_t)waited - holder_ran - gen_ran;
+	if (others_ran > (int64_t)holder_ran) {
+		inversions++;
+	}
+}
+
+static void subscriber(void *p1, void *p2, void *p3)
+{
+	const struct zbus_observer *sub = p1;
+	struct sub_stats *stats = p2;
+	bool watch_holder = p3 != NULL;
+	const struct zbus_channel *chan;
+	struct msg_button_evt msg;
+
+	while (running) {
+		if (zbus_sub_wait(sub, &chan, K_MSEC(10)) != 0 || chan != &chan_button_evt) {
+			continue;
+		}
+		/* Notifications only carry the channel; coalesced ones are counted as missed. */
+		stats->received++;
+		if (watch_holder) {
+			read_watching_holder(&msg);
+		} else {
+			(void)zbus_chan_read(chan, &msg, K_MSEC(10));
+		}
+	}
+}
+
+static void led_publisher(void *p1, void *p2, void *p3)
+{
+	struct msg_led_cmd cmd = {.led = POINTER_TO_UINT(p1)};
+
+	while (running) {
+		cmd.level ^= 1;
+		if (zbus_chan_pub(&chan_led_cmd, &cmd, K_MSEC(1)) != 0) {
+			atomic_inc(&led_failed);
+		}
+		k_usleep(LED_PERIOD_US);
+	}
+}
+
+static void generator(void *p1, void *p2, void *p3)
+{
+	int level = 1;
+
+	while (running) {
+		uint32_t start;
+
+		level ^= 1;
+
+		/* gpio-emul runs the edge through the whole pipeline before returning. */
+		start = k_cycle_get_32();
+		gpio_emul_input_set(button.port, button.pin, level);
+		if (sample_count < MAX_SAMPLES) {
+			samples[sample_count++] = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+		}
+		edges++;
+
+		k_usleep(GEN_PERIOD_US);
+	}
+
+	if (level == 0) {
+		gpio_emul_input_set(button.port, button.pin, 1);
+		edges++;
+	}
+}
+
+static void claimer(void *p1, void *p2, void *p3)
+{
+	while (running) {
+		if (zbus_chan_claim(&chan_button_evt, K_MSEC(10)) == 0) {
+			atomic_set(&claim_held, 1);
+			k_busy_wait(CLAIM_HOLD_US);
+			atomic_clear(&claim_held);
+			zbus_chan_finish(&chan_button_evt);
+		}
+		k_usleep(GEN_PERIOD_US * 3);
+	}
+}
+
+static int cmp_u32(const void *a, const void *b)
+{
+	uint32_t x = *(const uint32_t *)a;
+	uint32_t y = *(const uint32_t *)b;
+
+	return (x > y) - (x < y);
+}
+
+static uint32_t percentile(uint32_t p)
+{
+	return samples[MIN(sample_count - 1, sample_count * p / 100)];
+}
+
+ZTEST(contention, test_chan_button_evt_under_contention)
+{
+	uint32_t delivered;
+
+	/* Start released and forget the initial state events published at boot. */
+	gpio_emul_input_set(button.port, button.pin, 1);
+	k_msleep(4 * DT_PROP(BUTTON_NODE_LIST, debounce_interval_ms));
+	for (int i = 0; i < LISTENERS; i++) {
+		atomic_clear(&listener_calls[i]);
+	}
+
+	running = true;
+
+	for (int i = 0; i < SUBSCRIBERS; i++) {
+		k_thread_create(&sub_threads[i], sub_stacks[i], K_THREAD_STACK_SIZEOF(sub_stacks[i]),
+				subscriber, (void *)subs[i], &sub_stats[i], i == 0 ? (void *)1 : NULL,
+				K_PRIO_PREEMPT(2 + i), 0, K_NO_WAIT);
+	}
+	for (int i = 0; i < LED_PUBLISHERS; i++) {
+		k_thread_create(&led_threads[i], led_stacks[i], K_THREAD_STACK_SIZEOF(led_stacks[i]),
+				led_publisher, UINT_TO_POINTER(i), NULL, NULL,
+				K_PRIO_PREEMPT(3), 0, K_NO_WAIT);
+	}
+	k_thread_create(&claim_thread, claim_stack, K_THREAD_STACK_SIZEOF(claim_stack), claimer,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(2 + SUBSCRIBERS), 0, K_NO_WAIT);
+	k_thread_create(&gen_thread, gen_stack, K_THREAD_STACK_SIZEOF(gen_stack), generator, NULL,
+			NULL, NULL, K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+
+	k_msleep(RUN_MS);
+	running = false;
+
+	k_thread_join(&gen_thread, K_FOREVER);
+	k_thread_join(&claim_thread, K_FOREVER);
+	for (int i = 0; i < LED_PUBLISHERS; i++) {
+		k_thread_join(&led_threads[i], K_FOREVER);
+	}
+	for (int i = 0; i < SUBSCRIBERS; i++) {
+		k_thread_join(&sub_threads[i], K_FOREVER);
+	}
+
+	zassert_true(sample_count > 0);
+	qsort(samples, sample_count, sizeof(samples[0]), cmp_u32);
+
+	/* Every listener runs in every publish that went through. */
+	delivered = atomic_get(&listener_calls[0]);
+	for (int i = 1; i < LISTENERS; i++) {
+		zassert_equal(atomic_get(&listener_calls[i]), delivered);
+	}
+	zassert_true(delivered <= edges);
+
+	TC_PRINT("%u edges in %d ms, %u events dropped on a busy channel, "
+		 "%d LED publishes failed\n",
+		 edges, RUN_MS, edges - delivered, (int)atomic_get(&led_failed));
+	TC_PRINT("edge to published latency us: p50 %u p90 %u p99 %u max %u\n", percentile(50),
+		 percentile(90), percentile(99), samples[sample_count - 1]);
+	TC_PRINT("priority inversion incidents: %u of %u reads blocked by the claiming thread\n",
+		 inversions, blocked_reads);
+	for (int i = 0; i < SUBSCRIBERS; i++) {
+		TC_PRINT("subscriber %d (prio %d): %u received, %u missed\n", i, 2 + i,
+			 sub_stats[i].received, delivered - MIN(sub_stats[i].received, delivered));
+	}
+}
+
+ZTEST_SUITE(contention, NULL, NULL, NULL, NULL, NULL);
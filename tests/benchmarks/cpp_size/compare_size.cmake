@@ -0,0 +1,38 @@
+# SPDX-License-Identifier: Apache-2.0
+#
+# Fails when app_cpp.cpp compiles to more code than app_c.c. Code is the .text* and .rodata*
+# sections of each object, as listed by READELF. OBJECTS holds both objects.
+
+function(code_size obj out)
+  execute_process(COMMAND ${READELF} -S -W ${obj} OUTPUT_VARIABLE sections RESULT_VARIABLE ret)
+  if(NOT ret EQUAL 0)
+    message(FATAL_ERROR "${READELF} failed on ${obj}")
+  endif()
+
+  # "[Nr] Name Type Address Off Size ..."; the blank before the name skips .rela.text*.
+  string(REGEX MATCHALL " \\.(text|rodata)[^ ]* +[A-Z_]+ +[0-9a-f]+ +[0-9a-f]+ +[0-9a-f]+"
+         matches "${sections}")
+  set(total 0)
+  foreach(match ${matches})
+    string(REGEX REPLACE ".* ([0-9a-f]+)$" "\\1" size "${match}")
+    math(EXPR total "${total} + 0x${size}")
+  endforeach()
+  set(${out} ${total} PARENT_SCOPE)
+endfunction()
+
+foreach(obj ${OBJECTS})
+  if(obj MATCHES "app_c\\.c\\.")
+    code_size(${obj} c_size)
+  elseif(obj MATCHES "app_cpp\\.cpp\\.")
+    code_size(${obj} cpp_size)
+  endif()
+endforeach()
+
+if(NOT DEFINED c_size OR NOT DEFINED cpp_size)
+  message(FATAL_ERROR "Expected app_c.c and app_cpp.cpp objects, got ${OBJECTS}")
+endif()
+
+message(STATUS "cpp_size: C ${c_size} bytes, C++ ${cpp_size} bytes of code")
+if(cpp_size GREATER c_size)
+  message(FATAL_ERROR "The C++ API costs ${cpp_size} bytes of code against ${c_size} in C")
+endif()
@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2025 Rodrigo Peixoto <rodrigopex@ic.ufal.br>
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr/kernel.h>
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/zbus/zbus.h>
+
+#include "button.h"
+
+static const struct gpio_dt_spec led = GPIO_DT_SPEC_GET(DT_ALIAS(led0), gpios);
+
+static void ui_listener_cb(const struct zbus_channel *chan)
+{
+	const struct msg_button_evt *msg = zbus_chan_const_msg(chan);
+
+	if (msg->button != DT_NODE_CHILD_IDX(DT_ALIAS(sw0))) {
+		return;
+	}
+
+	switch (msg->evt) {
+	case BUTTON_EVT_PRESSED:
+		gpio_pin_toggle_dt(&led);
+		break;
+	case BUTTON_EVT_LONGPRESS:
+		gpio_pin_set_dt(&led, 0);
+		break;
+	default:
+		break;
+	}
+}
+
+ZBUS_LISTENER_DEFINE(ui_lis, ui_listener_cb);
+
+ZBUS_CHAN_ADD_OBS(chan_button_evt, ui_lis, 3);
+
+int main(void)
+{
+	if (!gpio_is_ready_dt(&led)) {
+		return -ENODEV;
+	}
+
+	return gpio_pin_configure_dt(&led, GPIO_OUTPUT_INACTIVE);
+}
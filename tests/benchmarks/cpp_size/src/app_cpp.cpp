@@ -0,0 +1,29 @@
+/*
+ * Copyright (c) 2025 Rodrigo Peixoto <rodrigopex@ic.ufal.br>
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr/kernel.h>
+
+#include "button.hpp"
+
+using Front = BUTTON_DT(DT_ALIAS(sw0));
+using Status = LED_DT(DT_ALIAS(led0));
+
+static void on_press(const msg_button_evt &)
+{
+	Status::toggle();
+}
+
+static void on_long_press(const msg_button_evt &)
+{
+	Status::off();
+}
+
+BUTTON_CPP_LISTENER_DEFINE(ui_lis, 3,
+			   button::Listener<Front::On<BUTTON_EVT_PRESSED, on_press>,
+					    Front::On<BUTTON_EVT_LONGPRESS, on_long_press>>);
+
+int main(void)
+{
+	return Status::init();
+}
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2025 Rodrigo Peixoto <rodrigopex@ic.ufal.br>
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/drivers/gpio/gpio_emul.h>
+
+#include "button.h"
+#include "traces.h"
+
+/*
+ * Replays each bounce trace on the emulated pin of one button per debounce algorithm (settle
+ * timer, integrator, majority vote, eager with and without glitch rejection, see the overlay)
+ * and reports, per algorithm: latency from the first edge of the trace to the first event of the
+ * transition it makes, as felt by the user; CPU cycles spent in the GPIO callbacks, which
+ * gpio-emul runs inside the replaying thread, and in the other threads; and false transitions,
+ * i.e. events beyond the one transition the trace makes (or any at all for noise).
+ */
+
+#define ITERATIONS 10
+#define SETTLE_MS  (BUTTON_DEBOUNCE_MS_DEFAULT * 3)
+
+#define BUTTON_GPIO_SPEC(node) GPIO_DT_SPEC_GET(node, gpios)
+
+static const struct gpio_dt_spec buttons[] = {
+	DT_FOREACH_CHILD_STATUS_OKAY_SEP(BUTTON_NODE_LIST, BUTTON_GPIO_SPEC, (,))};
+
+static const char *const algorithms[] = {"settle", "integrator", "majority", "eager",
+					 "eager+glitch"};
+
+BUILD_ASSERT(ARRAY_SIZE(algorithms) == BUTTON_COUNT, "one button per algorithm");
+
+static volatile uint32_t events;
+/* The event of the transition being replayed, and when it first arrived. */
+static volatile enum button_evt_type target_evt;
+static volatile bool target_seen;
+static volatile uint32_t received_at;
+
+static void bench_listener_cb(const struct zbus_channel *chan)
+{
+	const struct msg_button_evt *msg = zbus_chan_const_msg(chan);
+
+	if (msg->evt != BUTTON_EVT_PRESSED && msg->evt != BUTTON_EVT_RELEASED) {
+		return;
+	}
+
+	events++;
+	if (msg->evt == target_evt && !target_seen) {
+		received_at = k_cycle_get_32();
+		target_seen = true;
+	}
+}
+
+ZBUS_LISTENER_DEFINE(bench_lis, bench_listener_cb);
+
+ZBUS_CHAN_ADD_OBS(chan_button_evt, bench_lis, 3);
+
+static void busy_cycles_cb(const struct k_thread *thread, void *user_data)
+{
+	const char *name = k_thread_name_get((k_tid_t)thread);
+	k_thread_runtime_stats_t stats;
+
+	/* The replaying thread busy-waits through the trace; replay() times its callbacks. */
+	if ((name != NULL && strncmp(name, "idle", 4) == 0) || thread == k_current_get()) {
+		return;
+	}
+
+	if (k_thread_runtime_stats_get((k_tid_t)thread, &stats) == 0) {
+		*(uint64_t *)user_data += stats.execution_cycles;
+	}
+}
+
+static uint64_t busy_cycles(void)
+{
+	uint64_t total = 0;
+
+	k_thread_foreach_unlocked(busy_cycles_cb, &total);
+
+	return total;
+}
+
+/* Active low: the physical level of a logical one. */
+static void pin_set(const struct gpio_dt_spec *button, bool pressed)
+{
+	gpio_emul_input_set(button->port, button->pin, !pressed);
+}
+
+struct result {
+	uint32_t lat_min;
+	uint32_t lat_max;
+	uint64_t lat_sum;
+	uint32_t lat_count;
+	uint64_t busy;
+	uint64_t isr;
+	uint32_t false_transitions;
+};
+
+static void replay(const struct gpio_dt_spec *button, const struct bounce_trace *trace,
+		   struct result *res)
+{
+	uint32_t expected = trace->edges & 1;
+	bool level = trace->pressed;
+	uint64_t busy_start;
+	uint32_t first_edge = 0;
+	uint32_t start;
+
+	pin_set(button, trace->pressed);
+	k_msleep(SETTLE_MS);
+	events = 0;
+	target_evt = trace->pressed ? BUTTON_EVT_RELEASED : BUTTON_EVT_PRESSED;
+	target_seen = false;
+
+	busy_start = busy_cycles();
+	for (int i = 0; i < trace->edges; i++) {
+		k_busy_wait(trace->gaps_us[i]);
+		if (i == 0) {
+			first_edge = k_cycle_get_32();
+		}
+		level = !level;
+		start = k_cycle_get_32();
+		pin_set(button, level);
+		res->isr += k_cycle_get_32() - start;
+	}
+	k_msleep(SETTLE_MS);
+	res->busy += busy_cycles() - busy_start;
+
+	if (events > expected) {
+		res->false_transitions += events - expected;
+	}
+	if (expected == 1 && target_seen) {
+		uint32_t lat = received_at - first_edge;
+
+		res->lat_min = MIN(res->lat_min, lat);
+		res->lat_max = MAX(res->lat_max, lat);
+		res->lat_sum += lat;
+		res->lat_count++;
+	} else if (expected == 1) {
+		/* A missed transition is as wrong as an extra one. */
+		res->false_transitions++;
+	}
+}
+
+static void *debounce_setup(void)
+{
+	ARRAY_FOR_EACH(buttons, i) {
+		pin_set(&buttons[i], false);
+	}
+	k_msleep(SETTLE_MS);
+
+	return NULL;
+}
+
+ZTEST(debounce, test_bounce_traces)
+{
+	ARRAY_FOR_EACH(buttons, b) {
+		struct result res = {.lat_min = UINT32_MAX};
+		uint32_t replays = 0;
+
+		for (int n = 0; n < ITERATIONS; n++) {
+			ARRAY_FOR_EACH(traces, t) {
+				replay(&buttons[b], &traces[t], &res);
+				replays++;
+			}
+		}
+		pin_set(&buttons[b], false);
+		k_msleep(SETTLE_MS);
+
+		TC_PRINT("%-10s latency us: min %u avg %u max %u, cycles per trace: "
+			 "callbacks %llu threads %llu, false transitions %u/%u\n",
+			 algorithms[b], k_cyc_to_us_floor32(res.lat_min),
+			 res.lat_count ? k_cyc_to_us_floor32(res.lat_sum / res.lat_count) : 0,
+			 k_cyc_to_us_floor32(res.lat_max), res.isr / replays, res.busy / replays,
+			 res.false_transitions, replays);
+	}
+}
+
+ZTEST_SUITE(debounce, NULL, debounce_setup, NULL, NULL, NULL);
@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2025 Rodrigo Peixoto <rodrigopex@ic.ufal.br>
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef _TRACES_H_
+#define _TRACES_H_
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Switch bounce traces shaped after typical scope captures. The pin toggles after each gap
+ * in us, starting from the logical level in pressed. An odd number of gaps ends on a
+ * transition, an even one back where it started (noise that must not be reported).
+ */
+struct bounce_trace {
+	const char *name;
+	/* Logical level before the first edge. */
+	bool pressed;
+	const uint16_t *gaps_us;
+	uint8_t edges;
+};
+
+#define TRACE(_name, _pressed, ...)                                                                \
+	{                                                                                          \
+		.name = _name, .pressed = _pressed, .gaps_us = (const uint16_t[]){__VA_ARGS__},    \
+		.edges = sizeof((const uint16_t[]){__VA_ARGS__}) / sizeof(uint16_t),               \
+	}
+
+static const struct bounce_trace traces[] = {
+	/* Tactile dome switch, press and release: a few hundred us of bounce. */
+	TRACE("tactile press", false, 0, 90, 40, 210, 60, 480, 30),
+	TRACE("tactile release", true, 0, 60, 150, 40, 320),
+	/* Worn snap-action switch: 8 ms of chatter with long closed intervals. */
+	TRACE("snap chatter", false, 0, 400, 250, 1100, 300, 1900, 150, 2400, 100, 1300, 90),
+	/* Industrial limit switch on a long cable: bursts of chatter over 15 ms. */
+	TRACE("limit switch", false, 0, 50, 50, 700, 40, 60, 2100, 80, 30, 3500, 200, 4800, 70,
+	      2900, 120),
+	/* Interference on an idle line: short spikes, no real transition. */
+	TRACE("emi spikes", false, 0, 40, 1800, 30, 2500, 60, 900, 20),
+	/* A 3 ms dropout while held, e.g. a vibrating contact. */
+	TRACE("dropout", true, 0, 3000),
+};
+
+#endif /* _TRACES_H_ */
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2025 Rodrigo Peixoto <rodrigopex@ic.ufal.br>
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/drivers/gpio.h>
+
+#include "led_bcm.h"
+
+/*
+ * Dims every LED of the overlay for a second with the BCM driver, then with a naive software
+ * PWM (one timer per LED, switching it on and off once per frame of the same length), and
+ * reports timer interrupts per second and CPU load. Load is the share of a busy loop in the
+ * test thread lost to the interrupts, against a run with every LED static.
+ */
+
+#define WINDOW_MS 1000
+#define FRAME_US  ((LED_BCM_LEVELS - 1) * CONFIG_LED_BCM_BIT0_US)
+
+#define LED_GPIO_SPEC(node) GPIO_DT_SPEC_GET(node, gpios)
+
+static const struct gpio_dt_spec leds[] = {
+	DT_FOREACH_CHILD_STATUS_OKAY_SEP(LED_NODE_LIST, LED_GPIO_SPEC, (,))};
+
+struct naive_pwm {
+	struct k_timer timer;
+	uint8_t led;
+	uint8_t brightness;
+	bool on;
+	int64_t deadline;
+};
+
+static struct naive_pwm naive[LED_COUNT];
+static atomic_t naive_wakeups;
+
+static uint8_t level_of(uint8_t led)
+{
+	return 1 + led * (LED_BCM_LEVELS - 2) / MAX(LED_COUNT - 1, 1);
+}
+
+static void naive_handler(struct k_timer *timer)
+{
+	struct naive_pwm *pwm = CONTAINER_OF(timer, struct naive_pwm, timer);
+	uint32_t span = pwm->on ? LED_BCM_LEVELS - 1 - pwm->brightness : pwm->brightness;
+
+	atomic_inc(&naive_wakeups);
+
+	pwm->on = !pwm->on;
+	(void)gpio_pin_set_dt(&leds[pwm->led], pwm->on);
+	pwm->deadline += k_us_to_ticks_ceil64((uint64_t)span * CONFIG_LED_BCM_BIT0_US);
+	k_timer_start(timer, K_TIMEOUT_ABS_TICKS(pwm->deadline), K_NO_WAIT);
+}
+
+/* Iterations of an empty loop in WINDOW_MS, i.e. the CPU left to the test thread. */
+static uint64_t spin(void)
+{
+	uint32_t window = k_ms_to_cyc_ceil32(WINDOW_MS);
+	uint32_t start = k_cycle_get_32();
+	uint64_t loops = 0;
+
+	while (k_cycle_get_32() - start < window) {
+		loops++;
+	}
+
+	return loops;
+}
+
+static void report(const char *name, uint32_t wakeups, uint64_t loops, uint64_t idle_loops)
+{
+	uint32_t load = idle_loops > loops ? (idle_loops - loops) * 1000 / idle_loops : 0;
+
+	TC_PRINT("%-5s %u LEDs: %u interrupts/s (%u per frame), CPU load %u.%u%%\n", name,
+		 LED_COUNT, wakeups * MSEC_PER_SEC / WINDOW_MS,
+		 wakeups * FRAME_US / (WINDOW_MS * USEC_PER_MSEC), load / 10, load % 10);
+}
+
+ZTEST(led_bcm, test_bcm_vs_naive_pwm)
+{
+	uint64_t idle_loops;
+	uint64_t loops;
+	uint32_t wakeups;
+
+	zassert_ok(led_bcm_init());
+
+	idle_loops = spin();
+
+	wakeups = led_bcm_wakeups();
+	ARRAY_FOR_EACH(leds, i) {
+		zassert_ok(led_bcm_set(i, level_of(i)));
+	}
+	loops = spin();
+	wakeups = led_bcm_wakeups() - wakeups;
+	ARRAY_FOR_EACH(leds, i) {
+		zassert_ok(led_bcm_set(i, 0));
+	}
+	report("bcm", wakeups, loops, idle_loops);
+
+	ARRAY_FOR_EACH(naive, i) {
+		naive[i].led = i;
+		naive[i].brightness = level_of(i);
+		naive[i].on = false;
+		naive[i].deadline = k_uptime_ticks();
+		k_timer_init(&naive[i].timer, naive_handler, NULL);
+		k_timer_start(&naive[i].timer, K_NO_WAIT, K_NO_WAIT);
+	}
+	loops = spin();
+	wakeups = atomic_get(&naive_wakeups);
+	ARRAY_FOR_EACH(naive, i) {
+		k_timer_stop(&naive[i].timer);
+		(void)gpio_pin_set_dt(&leds[i], 0);
+	}
+	report("naive", wakeups, loops, idle_loops);
+}
+
+ZTEST_SUITE(led_bcm, NULL, NULL, NULL, NULL, NULL);
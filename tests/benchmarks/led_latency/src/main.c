@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2025 Rodrigo Peixoto <rodrigopex@ic.ufal.br>
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stdlib.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/drivers/gpio/gpio_emul.h>
+
+#include "button.h"
+
+/*
+ * Latency from an emulated edge on a button pin to the LED pin changing, through the whole
+ * pipeline: backend, debounce, core, zbus and a listener driving the LED the way an application
+ * would. The LED pin is also configured as an input, which gpio-emul loops its output back to,
+ * so a callback on it timestamps the change. One button per pipeline (see the overlay): a settle
+ * timer button, an eager button, and a "raw" button whose button-debounce entry selects "none",
+ * so its edges skip debouncing altogether and show the cost of the rest of the pipeline.
+ */
+
+#define ITERATIONS 1000
+#define SAMPLES    (ITERATIONS * 2)
+#define TIMEOUT_MS (BUTTON_DEBOUNCE_MS_DEFAULT * 4)
+
+#define BUTTON_GPIO_SPEC(node) GPIO_DT_SPEC_GET(node, gpios)
+
+static const struct gpio_dt_spec buttons[] = {
+	DT_FOREACH_CHILD_STATUS_OKAY_SEP(BUTTON_NODE_LIST, BUTTON_GPIO_SPEC, (,))};
+
+static const struct gpio_dt_spec led = GPIO_DT_SPEC_GET(DT_ALIAS(led0), gpios);
+
+static const char *const pipelines[] = {"debounced", "eager", "raw"};
+
+BUILD_ASSERT(ARRAY_SIZE(buttons) == ARRAY_SIZE(pipelines), "one button per pipeline");
+
+static struct gpio_callback led_cb;
+static K_SEM_DEFINE(led_changed, 0, 1);
+static volatile uint32_t changed_at;
+
+static uint32_t samples[SAMPLES];
+
+static void led_listener_cb(const struct zbus_channel *chan)
+{
+	const struct msg_button_evt *msg = zbus_chan_const_msg(chan);
+
+	if (msg->evt == BUTTON_EVT_PRESSED) {
+		(void)gpio_pin_set_dt(&led, 1);
+	} else if (msg->evt == BUTTON_EVT_RELEASED) {
+		(void)gpio_pin_set_dt(&led, 0);
+	}
+}
+
+ZBUS_LISTENER_DEFINE(led_lis, led_listener_cb);
+
+ZBUS_CHAN_ADD_OBS(chan_button_evt, led_lis, 3);
+
+static void led_edge(const struct device *dev, struct gpio_callback *cb, uint32_t pins)
+{
+	changed_at = k_cycle_get_32();
+	k_sem_give(&led_changed);
+}
+
+/* Active low: the physical level of a logical one. */
+static void pin_set(const struct gpio_dt_spec *button, bool pressed)
+{
+	gpio_emul_input_set(button->port, button->pin, !pressed);
+}
+
+static int cmp_u32(const void *a, const void *b)
+{
+	uint32_t x = *(const uint32_t *)a;
+	uint32_t y = *(const uint32_t *)b;
+
+	return (x > y) - (x < y);
+}
+
+static void *led_latency_setup(void)
+{
+	zassert_ok(gpio_pin_configure_dt(&led, GPIO_OUTPUT_INACTIVE | GPIO_INPUT));
+	gpio_init_callback(&led_cb, led_edge, BIT(led.pin));
+	zassert_ok(gpio_add_callback(led.port, &led_cb));
+	zassert_ok(gpio_pin_interrupt_configure_dt(&led, GPIO_INT_EDGE_BOTH));
+
+	ARRAY_FOR_EACH(buttons, i) {
+		pin_set(&buttons[i], false);
+	}
+	k_msleep(TIMEOUT_MS);
+
+	return NULL;
+}
+
+ZTEST(led_latency, test_button_to_led)
+{
+	struct button_stats stats;
+
+	/* The raw label is only honest if nothing debounces that button. */
+	zassert_ok(button_stats_get(2, &stats));
+	zassert_equal(stats.debounce_mode, BUTTON_DEBOUNCE_MODE_NONE);
+
+	ARRAY_FOR_EACH(buttons, b) {
+		uint32_t missed = 0;
+		uint32_t n = 0;
+
+		for (int i = 0; i < SAMPLES; i++) {
+			uint32_t start;
+
+			k_sem_reset(&led_changed);
+			start = k_cycle_get_32();
+			pin_set(&buttons[b], !(i & 1));
+
+			if (k_sem_take(&led_changed, K_MSEC(TIMEOUT_MS)) == 0) {
+				samples[n++] = changed_at - start;
+			} else {
+				missed++;
+			}
+
+			/* Lets a settle timer or eager lockout expire before the next edge. */
+			k_msleep(BUTTON_DEBOUNCE_MS_DEFAULT + 5);
+		}
+
+		zassert_equal(missed, 0, "%s: LED missed %u of %u edges", pipelines[b], missed,
+			      SAMPLES);
+
+		qsort(samples, n, sizeof(samples[0]), cmp_u32);
+
+		TC_PRINT("%-9s latency us: min %u median %u p99 %u max %u (%u edges)\n",
+			 pipelines[b], k_cyc_to_us_floor32(samples[0]),
+			 k_cyc_to_us_floor32(samples[n / 2]),
+			 k_cyc_to_us_floor32(samples[n * 99 / 100]),
+			 k_cyc_to_us_floor32(samples[n - 1]), n);
+	}
+}
+
+ZTEST_SUITE(led_latency, NULL, led_latency_setup, NULL, NULL, NULL);
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2025 Rodrigo Peixoto <rodrigopex@ic.ufal.br>
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/random/random.h>
+
+#include "button_time.h"
+
+/*
+ * Per-event cost of turning a cycle timestamp into microseconds: kernel conversion against the
+ * button module's fixed-point helper. Timings under QEMU are only reported, never asserted.
+ *
+ * qemu_riscv32 counts at 10 MHz, which divides evenly into microseconds, so the default build
+ * gives the kernel a constant 32-bit divide. The runtime_freq scenario reads the frequency at
+ * runtime, which forces the kernel onto its 64-bit division while the helper keeps its
+ * multipliers; that is the case the helper is for.
+ */
+
+#define SAMPLES 4096
+
+static uint32_t samples[SAMPLES];
+static volatile uint32_t sink;
+
+static uint32_t kernel_conv(uint32_t cycles)
+{
+	return k_cyc_to_us_floor32(cycles);
+}
+
+static uint32_t fixed_conv(uint32_t cycles)
+{
+	return button_cyc_to_us(cycles);
+}
+
+static uint32_t run(uint32_t (*conv)(uint32_t))
+{
+	uint32_t start = k_cycle_get_32();
+
+	for (int i = 0; i < SAMPLES; i++) {
+		sink = conv(samples[i]);
+	}
+
+	return k_cycle_get_32() - start;
+}
+
+ZTEST(time_conv, test_cyc_to_us_matches_kernel)
+{
+	sys_rand_get(samples, sizeof(samples));
+
+	ARRAY_FOR_EACH(samples, i) {
+		uint32_t kernel = kernel_conv(samples[i]);
+		uint32_t fixed = fixed_conv(samples[i]);
+
+		zassert_true(fixed - kernel <= 1, "%u cycles: %u us, kernel says %u", samples[i],
+			     fixed, kernel);
+	}
+}
+
+ZTEST(time_conv, test_cyc_to_us_cost)
+{
+	uint32_t kernel;
+	uint32_t fixed;
+
+	sys_rand_get(samples, sizeof(samples));
+
+	/* Warm up the caches so both runs see the same memory behaviour. */
+	(void)run(fixed_conv);
+	(void)run(kernel_conv);
+
+	kernel = run(kernel_conv);
+	fixed = run(fixed_conv);
+
+	TC_PRINT("%s frequency\n",
+		 IS_ENABLED(CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME) ? "runtime" : "fixed");
+	TC_PRINT("k_cyc_to_us_floor32: %u cycles per call\n", kernel / SAMPLES);
+	TC_PRINT("button_cyc_to_us:    %u cycles per call\n", fixed / SAMPLES);
+}
+
+static void *time_conv_setup(void)
+{
+	/* Also run by button_init(); makes the runtime multipliers explicit here. */
+	button_time_init();
+
+	return NULL;
+}
+
+ZTEST_SUITE(time_conv, NULL, time_conv_setup, NULL, NULL, NULL);
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2025 Rodrigo Peixoto <rodrigopex@ic.ufal.br>
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/drivers/gpio/gpio_emul.h>
+
+#include "button.h"
+
+/*
+ * Edge-to-listener latency while the system workqueue is kept busy with 5 ms work items, as
+ * flash or logging work would. The debounce interval is subtracted, so the numbers are the delay
+ * the pipeline adds on top of it.
+ */
+
+#define ITERATIONS  100
+#define DEBOUNCE_MS DT_PROP(BUTTON_NODE_LIST, debounce_interval_ms)
+#define LOAD_MS     5
+
+static const struct gpio_dt_spec button_gpio = GPIO_DT_SPEC_GET(DT_ALIAS(sw0), gpios);
+
+static volatile uint32_t received_at;
+static volatile bool load_running;
+
+static void bench_listener_cb(const struct zbus_channel *chan)
+{
+	received_at = k_cycle_get_32();
+}
+
+ZBUS_LISTENER_DEFINE(bench_lis, bench_listener_cb);
+
+ZBUS_CHAN_ADD_OBS(chan_button_evt, bench_lis, 3);
+
+static void load_handler(struct k_work *work)
+{
+	k_busy_wait(LOAD_MS * USEC_PER_MSEC);
+
+	if (load_running) {
+		k_work_submit(work);
+	}
+}
+
+static K_WORK_DEFINE(load_work, load_handler);
+
+static void *workq_jitter_setup(void)
+{
+	button_init();
+
+	gpio_emul_input_set(button_gpio.port, button_gpio.pin, 1);
+
+	button_enable_interrupts();
+
+	k_msleep(2 * DEBOUNCE_MS);
+
+	return NULL;
+}
+
+ZTEST(workq_jitter, test_latency_under_system_workq_load)
+{
+	uint32_t lat_min = UINT32_MAX;
+	uint32_t lat_max = 0;
+	uint64_t lat_sum = 0;
+	uint32_t debounce_cyc = k_ms_to_cyc_ceil32(DEBOUNCE_MS);
+
+	load_running = true;
+	k_work_submit(&load_work);
+
+	for (int i = 0; i < ITERATIONS * 2; i++) {
+		uint32_t start;
+		uint32_t lat;
+
+		received_at = 0;
+		/* Spread the edges over the load period. */
+		k_busy_wait((i * 397) % (LOAD_MS * USEC_PER_MSEC));
+		start = k_cycle_get_32();
+		gpio_emul_input_set(button_gpio.port, button_gpio.pin, i & 1);
+		k_msleep(DEBOUNCE_MS + 4 * LOAD_MS);
+
+		zassert_not_equal(received_at, 0, "no event for edge %d", i);
+
+		lat = received_at - start - debounce_cyc;
+		lat_min = MIN(lat_min, lat);
+		lat_max = MAX(lat_max, lat);
+		lat_sum += lat;
+	}
+
+	load_running = false;
+	k_msleep(2 * LOAD_MS);
+
+	TC_PRINT("workqueue: %s\n", IS_ENABLED(CONFIG_BUTTON_WORKQ) ? "button" : "system");
+	TC_PRINT("added latency us: min %u avg %u max %u jitter %u\n", k_cyc_to_us_floor32(lat_min),
+		 k_cyc_to_us_floor32(lat_sum / (ITERATIONS * 2)), k_cyc_to_us_floor32(lat_max),
+		 k_cyc_to_us_floor32(lat_max - lat_min));
+}
+
+ZTEST_SUITE(workq_jitter, NULL, workq_jitter_setup, NULL, NULL, NULL);
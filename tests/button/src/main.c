@@ -2,6 +2,7 @@
  * Copyright (c) 2025 Rodrigo Peixoto <rodrigopex@ic.ufal.br>
  * SPDX-License-Identifier: Apache-2.0
  */
+#include <string.h>
 #include <zephyr/kernel.h>
 #include <zephyr/ztest.h>
 #include <zephyr/zbus/zbus.h>
@@ -44,6 +45,25 @@ static void *button_test_setup(void)
 	return &fixture;
 }
 
+static void button_test_before(void *f)
+{
+	const struct zbus_channel *chan;
+	struct msg_button_evt msg;
+
+	/* Drop the initial state events and anything left over by the previous test. */
+	k_msleep(2 * DT_PROP(BUTTON_NODE_LIST, debounce_interval_ms));
+	while (zbus_sub_wait_msg(&msub_button_evt, &chan, &msg, K_NO_WAIT) == 0) {
+	}
+}
+
+ZTEST_F(button, test_00_held_at_boot)
+{
+	/* gpio-emul inputs start low, so the active-low button reads as held at boot. */
+	zassert_true(button_boot_combo(BIT(0)));
+
+	TC_PRINT("ready %u us after reset\n", k_cyc_to_us_floor32(button_ready_cycles()));
+}
+
 ZTEST_F(button, test_01_single_press)
 {
 	const struct zbus_channel *chan;
@@ -88,4 +108,284 @@ ZTEST_F(button, test_02_long_press)
 	zassert_true(msg.evt == BUTTON_EVT_LONGPRESS);
 }
 
-ZTEST_SUITE(button, NULL, button_test_setup, NULL, NULL, NULL);
+static void button_cfg_restore(void)
+{
+	struct button_cfg cfg = {
+		.debounce_ms = DT_PROP(BUTTON_NODE_LIST, debounce_interval_ms),
+		.long_press_ms = CONFIG_BUTTON_LONG_PRESS_MS,
+		.repeat_delay_ms = CONFIG_BUTTON_REPEAT_DELAY_MS,
+		.repeat_interval_ms = CONFIG_BUTTON_REPEAT_INTERVAL_MS,
+	};
+
+	zassert_ok(button_cfg_set(BUTTON_CFG_ALL, &cfg));
+}
+
+ZTEST_F(button, test_03_long_press_threshold_changed_mid_press)
+{
+	const struct zbus_channel *chan;
+	struct msg_button_evt msg = {.evt = BUTTON_EVT_UNDEFINED};
+	struct button_cfg cfg;
+
+	zassert_ok(button_cfg_get(0, &cfg));
+	cfg.long_press_ms = 5000;
+	zassert_ok(button_cfg_set(0, &cfg));
+
+	BUTTON_PRESS(fixture);
+
+	zbus_sub_wait_msg(&msub_button_evt, &chan, &msg, K_SECONDS(1));
+
+	zassert_true(msg.evt == BUTTON_EVT_PRESSED);
+
+	/* The press keeps the 5 s threshold it started with. */
+	cfg.long_press_ms = 500;
+	zassert_ok(button_cfg_set(0, &cfg));
+
+	k_msleep(1500);
+
+	BUTTON_RELEASE(fixture);
+
+	zbus_sub_wait_msg(&msub_button_evt, &chan, &msg, K_SECONDS(1));
+
+	zassert_true(msg.evt == BUTTON_EVT_RELEASED);
+
+	zassert_equal(zbus_sub_wait_msg(&msub_button_evt, &chan, &msg, K_MSEC(200)), -ENOMSG);
+
+	/* The next press picks up the 500 ms threshold. */
+	BUTTON_PRESS(fixture);
+
+	zbus_sub_wait_msg(&msub_button_evt, &chan, &msg, K_SECONDS(1));
+
+	zassert_true(msg.evt == BUTTON_EVT_PRESSED);
+
+	k_msleep(1000);
+
+	BUTTON_RELEASE(fixture);
+
+	zbus_sub_wait_msg(&msub_button_evt, &chan, &msg, K_SECONDS(1));
+
+	zassert_true(msg.evt == BUTTON_EVT_RELEASED);
+
+	zbus_sub_wait_msg(&msub_button_evt, &chan, &msg, K_SECONDS(1));
+
+	zassert_true(msg.evt == BUTTON_EVT_LONGPRESS);
+
+	button_cfg_restore();
+}
+
+ZTEST_F(button, test_04_repeat_configured_over_zbus)
+{
+	const struct zbus_channel *chan;
+	struct msg_button_evt msg = {.evt = BUTTON_EVT_UNDEFINED};
+	struct msg_button_cfg cfg_msg = {.button = 0};
+	int repeats = 0;
+
+	zassert_ok(button_cfg_get(0, &cfg_msg.cfg));
+
+	cfg_msg.cfg.debounce_ms = 0;
+	zassert_equal(zbus_chan_pub(&chan_button_cfg, &cfg_msg, K_MSEC(100)), -ENOMSG);
+
+	cfg_msg.cfg.debounce_ms = DT_PROP(BUTTON_NODE_LIST, debounce_interval_ms);
+	cfg_msg.cfg.repeat_delay_ms = 300;
+	cfg_msg.cfg.repeat_interval_ms = 100;
+	zassert_ok(zbus_chan_pub(&chan_button_cfg, &cfg_msg, K_MSEC(100)));
+
+	BUTTON_PRESS(fixture);
+
+	zbus_sub_wait_msg(&msub_button_evt, &chan, &msg, K_SECONDS(1));
+
+	zassert_true(msg.evt == BUTTON_EVT_PRESSED);
+
+	/* A slower rate published mid-press applies from the next press only. */
+	cfg_msg.cfg.repeat_interval_ms = 1000;
+	zassert_ok(zbus_chan_pub(&chan_button_cfg, &cfg_msg, K_MSEC(100)));
+
+	k_msleep(720);
+
+	BUTTON_RELEASE(fixture);
+
+	while (zbus_sub_wait_msg(&msub_button_evt, &chan, &msg, K_MSEC(200)) == 0 &&
+	       msg.evt == BUTTON_EVT_REPEAT) {
+		repeats++;
+	}
+
+	zassert_true(msg.evt == BUTTON_EVT_RELEASED);
+	/* Held for ~800 ms: repeats at 300, 400, ..., 800 ms. */
+	zassert_between_inclusive(repeats, 4, 6);
+
+	button_cfg_restore();
+}
+
+ZTEST_F(button, test_05_state_snapshot)
+{
+	const struct zbus_channel *chan;
+	struct msg_button_evt msg = {.evt = BUTTON_EVT_UNDEFINED};
+	uint32_t held;
+
+	zassert_false(button_is_pressed(0));
+	zassert_equal(button_pressed_mask(), 0);
+	zassert_equal(button_held_for(0), 0);
+	zassert_false(button_is_pressed(BUTTON_COUNT));
+
+	BUTTON_PRESS(fixture);
+
+	zbus_sub_wait_msg(&msub_button_evt, &chan, &msg, K_SECONDS(1));
+
+	zassert_true(msg.evt == BUTTON_EVT_PRESSED);
+	zassert_true(button_is_pressed(0));
+	zassert_equal(button_pressed_mask(), BIT(0));
+
+	k_msleep(500);
+
+	/* Counted from the debounced edge, ~30 ms after the pin changed 580 ms ago. */
+	held = button_held_for(0);
+	zassert_between_inclusive(held, 500, 600, "held for %u ms", held);
+
+	BUTTON_RELEASE(fixture);
+
+	zbus_sub_wait_msg(&msub_button_evt, &chan, &msg, K_SECONDS(1));
+
+	zassert_true(msg.evt == BUTTON_EVT_RELEASED);
+	zassert_false(button_is_pressed(0));
+	zassert_equal(button_held_for(0), 0);
+}
+
+ZTEST_F(button, test_06_hold_levels_and_duration)
+{
+	const struct zbus_channel *chan;
+	struct msg_button_evt msg = {.evt = BUTTON_EVT_UNDEFINED};
+	const uint16_t hold_ms[] = {200, 500, 900};
+	struct button_cfg cfg;
+
+	zassert_ok(button_cfg_get(0, &cfg));
+	memcpy(cfg.hold_ms, hold_ms, sizeof(cfg.hold_ms));
+	zassert_ok(button_cfg_set(0, &cfg));
+
+	BUTTON_PRESS(fixture);
+
+	zbus_sub_wait_msg(&msub_button_evt, &chan, &msg, K_SECONDS(1));
+
+	zassert_true(msg.evt == BUTTON_EVT_PRESSED);
+
+	for (int level = 1; level <= ARRAY_SIZE(hold_ms); level++) {
+		zbus_sub_wait_msg(&msub_button_evt, &chan, &msg, K_SECONDS(1));
+
+		zassert_true(msg.evt == BUTTON_EVT_HOLD);
+		zassert_equal(msg.hold_level, level);
+		zassert_between_inclusive(msg.held_ms, hold_ms[level - 1], hold_ms[level - 1] + 20);
+	}
+
+	k_msleep(200);
+
+	BUTTON_RELEASE(fixture);
+
+	zbus_sub_wait_msg(&msub_button_evt, &chan, &msg, K_SECONDS(1));
+
+	zassert_true(msg.evt == BUTTON_EVT_RELEASED);
+	/* Released 200 ms after the last level; both edges are delayed by the same debounce. */
+	zassert_between_inclusive(msg.held_ms, 1100, 1200, "held %u ms", msg.held_ms);
+
+	/* Decreasing thresholds are rejected. */
+	cfg.hold_ms[2] = 100;
+	zassert_equal(button_cfg_set(0, &cfg), -EINVAL);
+
+	button_cfg_restore();
+}
+
+ZTEST_F(button, test_07_debounce_mode)
+{
+	struct button_stats stats;
+
+	zassert_ok(button_stats_get(0, &stats));
+
+	/* gpio-emul stores the flag without filtering, so hardware debounce falls back. */
+	zassert_equal(stats.debounce_mode, BUTTON_DEBOUNCE_MODE_SOFTWARE);
+}
+
+ZTEST_F(button, test_08_missed_release_recovered)
+{
+	const struct zbus_channel *chan;
+	struct msg_button_evt msg = {.evt = BUTTON_EVT_UNDEFINED};
+	struct button_stats before;
+	struct button_stats after;
+
+	/* gpio-keys keeps its own idea of the level, which a lost edge leaves stale. */
+	Z_TEST_SKIP_IFDEF(CONFIG_BUTTON_BACKEND_INPUT);
+	/* A level interrupt is still pending once unmasked, see test_09. */
+	Z_TEST_SKIP_IFDEF(CONFIG_BUTTON_LEVEL_IRQ);
+
+	zassert_ok(button_stats_get(0, &before));
+
+	BUTTON_PRESS(fixture);
+
+	zbus_sub_wait_msg(&msub_button_evt, &chan, &msg, K_SECONDS(1));
+
+	zassert_true(msg.evt == BUTTON_EVT_PRESSED);
+
+	/* Release with the interrupt masked, so the edge is never seen. */
+	zassert_ok(gpio_pin_interrupt_configure_dt(&fixture->button_gpio, GPIO_INT_DISABLE));
+	gpio_emul_input_set(fixture->button_gpio.port, fixture->button_gpio.pin, 1);
+	zassert_ok(gpio_pin_interrupt_configure_dt(&fixture->button_gpio, GPIO_INT_EDGE_BOTH));
+
+	zassert_equal(zbus_sub_wait_msg(&msub_button_evt, &chan, &msg, K_MSEC(100)), -ENOMSG);
+	zassert_true(button_is_pressed(0));
+
+	/* Two mismatching checks, then the debounce of the resync. */
+	zbus_sub_wait_msg(&msub_button_evt, &chan, &msg, K_MSEC(3 * CONFIG_BUTTON_RECONCILE_MS));
+
+	zassert_true(msg.evt == BUTTON_EVT_RELEASED);
+	zassert_true(msg.flags & BUTTON_EVT_FLAG_RECOVERED);
+	zassert_false(button_is_pressed(0));
+
+	zassert_ok(button_stats_get(0, &after));
+	zassert_equal(after.recovered - before.recovered, 1);
+
+	/* Back in sync: the next press is an ordinary one. */
+	BUTTON_PRESS(fixture);
+
+	zbus_sub_wait_msg(&msub_button_evt, &chan, &msg, K_SECONDS(1));
+
+	zassert_true(msg.evt == BUTTON_EVT_PRESSED);
+	zassert_false(msg.flags & BUTTON_EVT_FLAG_RECOVERED);
+
+	BUTTON_RELEASE(fixture);
+}
+
+ZTEST_F(button, test_09_level_irq_late_isr)
+{
+	const struct zbus_channel *chan;
+	struct msg_button_evt msg = {.evt = BUTTON_EVT_UNDEFINED};
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_BUTTON_LEVEL_IRQ);
+
+	BUTTON_PRESS(fixture);
+
+	zbus_sub_wait_msg(&msub_button_evt, &chan, &msg, K_SECONDS(1));
+
+	zassert_true(msg.evt == BUTTON_EVT_PRESSED);
+
+	/* Release with the interrupt masked, as if the ISR ran late. */
+	zassert_ok(gpio_pin_interrupt_configure_dt(&fixture->button_gpio, GPIO_INT_DISABLE));
+	gpio_emul_input_set(fixture->button_gpio.port, fixture->button_gpio.pin, 1);
+	k_msleep(80);
+	zassert_equal(zbus_sub_wait_msg(&msub_button_evt, &chan, &msg, K_NO_WAIT), -ENOMSG);
+
+	/* Unmasked as the press left it: the release is still pending. */
+	zassert_ok(gpio_pin_interrupt_configure_dt(&fixture->button_gpio,
+						   GPIO_INT_LEVEL_INACTIVE));
+
+	zbus_sub_wait_msg(&msub_button_evt, &chan, &msg, K_SECONDS(1));
+
+	zassert_true(msg.evt == BUTTON_EVT_RELEASED);
+	zassert_false(msg.flags & BUTTON_EVT_FLAG_RECOVERED);
+
+	/* The ISR flipped the level, so the next press is seen as usual. */
+	BUTTON_PRESS(fixture);
+
+	zbus_sub_wait_msg(&msub_button_evt, &chan, &msg, K_SECONDS(1));
+
+	zassert_true(msg.evt == BUTTON_EVT_PRESSED);
+
+	BUTTON_RELEASE(fixture);
+}
+
+ZTEST_SUITE(button, NULL, button_test_setup, button_test_before, NULL, NULL);
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2025 Rodrigo Peixoto <rodrigopex@ic.ufal.br>
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/drivers/gpio/gpio_emul.h>
+
+#include "button.h"
+#include "button_obs.h"
+
+static volatile bool slow_enabled;
+static volatile bool plain_slow_enabled;
+
+static void fast_listener_cb(const struct zbus_channel *chan)
+{
+}
+
+static void slow_listener_cb(const struct zbus_channel *chan)
+{
+	if (slow_enabled) {
+		k_busy_wait(4 * CONFIG_BUTTON_OBS_BUDGET_US);
+	}
+}
+
+/* Not timed on its own; only the channel entry sees it. */
+static void plain_slow_listener_cb(const struct zbus_channel *chan)
+{
+	if (plain_slow_enabled) {
+		k_busy_wait(2 * CONFIG_BUTTON_OBS_CHAN_BUDGET_US);
+	}
+}
+
+BUTTON_LISTENER_DEFINE(obs_fast_lis, fast_listener_cb);
+ZBUS_LISTENER_DEFINE(obs_plain_slow_lis, plain_slow_listener_cb);
+BUTTON_LISTENER_DEFINE(obs_slow_lis, slow_listener_cb);
+
+ZBUS_CHAN_ADD_OBS(chan_button_evt, obs_fast_lis, 4);
+ZBUS_CHAN_ADD_OBS(chan_button_evt, obs_slow_lis, 4);
+ZBUS_CHAN_ADD_OBS(chan_button_evt, obs_plain_slow_lis, 4);
+
+ZBUS_MSG_SUBSCRIBER_DEFINE(msub_obs_stats);
+
+ZBUS_CHAN_ADD_OBS(chan_button_obs_stats, msub_obs_stats, 3);
+
+static void obs_before(void *f)
+{
+	const struct zbus_channel *chan;
+	struct button_obs_stats stats;
+
+	button_obs_stats_reset();
+	while (zbus_sub_wait_msg(&msub_obs_stats, &chan, &stats, K_NO_WAIT) == 0) {
+	}
+}
+
+static void obs_after(void *f)
+{
+	const struct gpio_dt_spec button = GPIO_DT_SPEC_GET(DT_ALIAS(sw0), gpios);
+
+	slow_enabled = false;
+	plain_slow_enabled = false;
+	gpio_emul_input_set(button.port, button.pin, 1);
+}
+
+ZTEST(button_obs, test_01_slow_listener_flagged)
+{
+	const struct zbus_channel *chan;
+	struct msg_button_evt msg = {.evt = BUTTON_EVT_UNDEFINED, .button = 0};
+	struct button_obs_stats stats;
+
+	slow_enabled = true;
+
+	for (int i = 0; i < 3; i++) {
+		zassert_ok(zbus_chan_pub(&chan_button_evt, &msg, K_MSEC(100)));
+	}
+
+	zassert_ok(zbus_sub_wait_msg(&msub_obs_stats, &chan, &stats, K_MSEC(100)));
+	zassert_str_equal(stats.name, "obs_slow_lis");
+	zassert_true(k_cyc_to_us_floor32(stats.last_cycles) >= 4 * CONFIG_BUTTON_OBS_BUDGET_US);
+
+	zassert_ok(button_obs_stats_get("obs_slow_lis", &stats));
+	zassert_equal(stats.calls, 3);
+	zassert_equal(stats.over_budget, 3);
+	zassert_true(stats.avg_cycles <= stats.max_cycles);
+
+	zassert_ok(button_obs_stats_get("obs_fast_lis", &stats));
+	zassert_equal(stats.calls, 3);
+	zassert_equal(stats.over_budget, 0);
+}
+
+ZTEST(button_obs, test_02_unknown_listener)
+{
+	struct button_obs_stats stats;
+
+	zassert_equal(button_obs_stats_get("nope", &stats), -ENOENT);
+}
+
+ZTEST(button_obs, test_03_plain_listener_caught_by_channel)
+{
+	const struct gpio_dt_spec button = GPIO_DT_SPEC_GET(DT_ALIAS(sw0), gpios);
+	const struct zbus_channel *chan;
+	struct button_obs_stats stats;
+
+	/* Start from a released button, whichever suite ran before. */
+	gpio_emul_input_set(button.port, button.pin, 1);
+	k_msleep(4 * DT_PROP(BUTTON_NODE_LIST, debounce_interval_ms));
+	button_obs_stats_reset();
+	plain_slow_enabled = true;
+
+	gpio_emul_input_set(button.port, button.pin, 0);
+	k_msleep(4 * DT_PROP(BUTTON_NODE_LIST, debounce_interval_ms));
+	gpio_emul_input_set(button.port, button.pin, 1);
+	k_msleep(4 * DT_PROP(BUTTON_NODE_LIST, debounce_interval_ms));
+
+	zassert_ok(zbus_sub_wait_msg(&msub_obs_stats, &chan, &stats, K_MSEC(100)));
+	zassert_str_equal(stats.name, "chan_button_evt");
+
+	zassert_ok(button_obs_stats_get("chan_button_evt", &stats));
+	zassert_equal(stats.calls, 2, "PRESSED and RELEASED");
+	zassert_equal(stats.over_budget, 2);
+}
+
+ZTEST_SUITE(button_obs, NULL, NULL, obs_before, obs_after, NULL);
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2025 Rodrigo Peixoto <rodrigopex@ic.ufal.br>
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include "button_time.h"
+
+static void check_cycles(uint32_t cycles)
+{
+	uint32_t us = button_cyc_to_us(cycles);
+	uint32_t ms = button_cyc_to_ms(cycles);
+	uint32_t ref_us = k_cyc_to_us_floor32(cycles);
+	uint32_t ref_ms = k_cyc_to_ms_floor32(cycles);
+
+	zassert_true(us - ref_us <= 1, "%u cycles: %u us, kernel says %u", cycles, us, ref_us);
+	zassert_true(ms - ref_ms <= 1, "%u cycles: %u ms, kernel says %u", cycles, ms, ref_ms);
+}
+
+ZTEST(button_time, test_01_matches_kernel_conversion)
+{
+	uint32_t hz = sys_clock_hw_cycles_per_sec();
+	uint32_t cycles = 1;
+
+	check_cycles(0);
+	check_cycles(UINT32_MAX);
+	check_cycles(hz);
+	check_cycles(hz - 1);
+	check_cycles(hz / 1000);
+
+	/* Walk the whole 32-bit range with a step that is not a multiple of the frequency. */
+	for (int i = 0; i < 100000; i++) {
+		check_cycles(cycles);
+		cycles += 42949 + (cycles & 0xff);
+		if (cycles < 42949) {
+			break;
+		}
+	}
+}
+
+ZTEST(button_time, test_02_exact_on_whole_units)
+{
+	uint32_t hz = sys_clock_hw_cycles_per_sec();
+
+	zassert_equal(button_cyc_to_ms(hz), MSEC_PER_SEC);
+	zassert_equal(button_cyc_to_ms(hz * 3), 3 * MSEC_PER_SEC);
+	zassert_equal(button_cyc_to_us(hz), USEC_PER_SEC);
+}
+
+ZTEST_SUITE(button_time, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2025 Rodrigo Peixoto <rodrigopex@ic.ufal.br>
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/drivers/gpio/gpio_emul.h>
+
+#include "button.hpp"
+
+using Front = BUTTON_DT(DT_ALIAS(sw0));
+using Status = LED_DT(DT_ALIAS(led0));
+
+static_assert(Front::index == 0);
+static_assert(Status::spec.pin == DT_GPIO_PIN(DT_ALIAS(led0), gpios));
+
+static constexpr button_cfg front_cfg = {30, 800, 0, 100, {500, 1500, 0}};
+static constexpr button_cfg reversed_holds = {30, 800, 0, 100, {1500, 500, 0}};
+
+using Configured = BUTTON_DT_CFG(DT_ALIAS(sw0), front_cfg);
+
+static_assert(Configured::index == Front::index);
+static_assert(button::cfg_valid(front_cfg));
+/* Button<0, &reversed_holds> would fail to compile. */
+static_assert(!button::cfg_valid(reversed_holds));
+
+static int presses;
+static int long_presses;
+
+static void on_press(const msg_button_evt &)
+{
+	presses++;
+	Status::toggle();
+}
+
+static void on_long_press(const msg_button_evt &)
+{
+	long_presses++;
+}
+
+BUTTON_CPP_LISTENER_DEFINE(cpp_lis, 3,
+			   button::Listener<Front::On<BUTTON_EVT_PRESSED, on_press>,
+					    Front::On<BUTTON_EVT_LONGPRESS, on_long_press>>);
+
+static void publish(button_evt_type evt, uint8_t idx)
+{
+	msg_button_evt msg{};
+
+	msg.evt = evt;
+	msg.button = idx;
+	zassert_ok(zbus_chan_pub(&chan_button_evt, &msg, K_MSEC(100)));
+}
+
+static int led_level()
+{
+	return gpio_emul_output_get(Status::spec.port, Status::spec.pin);
+}
+
+static void cpp_before(void *)
+{
+	presses = 0;
+	long_presses = 0;
+}
+
+ZTEST(button_cpp, test_01_dispatch_by_button_and_event)
+{
+	publish(BUTTON_EVT_PRESSED, Front::index);
+	publish(BUTTON_EVT_RELEASED, Front::index);
+	publish(BUTTON_EVT_LONGPRESS, Front::index);
+	/* Not our button. */
+	publish(BUTTON_EVT_PRESSED, Front::index + 1);
+
+	zassert_equal(presses, 1);
+	zassert_equal(long_presses, 1);
+}
+
+ZTEST(button_cpp, test_02_led_follows_handler)
+{
+	zassert_ok(Status::init());
+	zassert_equal(led_level(), 0);
+
+	publish(BUTTON_EVT_PRESSED, Front::index);
+	zassert_equal(led_level(), 1);
+
+	publish(BUTTON_EVT_PRESSED, Front::index);
+	zassert_equal(led_level(), 0);
+}
+
+ZTEST(button_cpp, test_03_config_roundtrip)
+{
+	button_cfg cfg = Front::config();
+
+	cfg.long_press_ms = 1234;
+	zassert_ok(Front::config(cfg));
+	zassert_equal(Front::config().long_press_ms, 1234);
+}
+
+ZTEST(button_cpp, test_04_constexpr_config_applied_by_init)
+{
+	zassert_ok(Configured::init());
+	zassert_equal(Front::config().long_press_ms, front_cfg.long_press_ms);
+	zassert_equal(Front::config().hold_ms[1], front_cfg.hold_ms[1]);
+}
+
+ZTEST_SUITE(button_cpp, NULL, NULL, cpp_before, NULL, NULL);
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2025 Rodrigo Peixoto <rodrigopex@ic.ufal.br>
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/drivers/gpio/gpio_emul.h>
+
+#include "button.h"
+
+/* Button indexes, in the order of the overlay. */
+#define SETTLE     0
+#define INTEGRATOR 1
+#define MAJORITY   2
+#define EAGER      3
+#define EAGER_GR   4
+
+#define GLITCH_REJECT_US                                                                           \
+	DT_PROP(DT_CHILD(DT_COMPAT_GET_ANY_STATUS_OKAY(button_debounce), eager_glitch),            \
+		glitch_reject_us)
+
+#define SETTLE_MS (BUTTON_DEBOUNCE_MS_DEFAULT * 3)
+
+#define BUTTON_GPIO_SPEC(node) GPIO_DT_SPEC_GET(node, gpios)
+
+static const struct gpio_dt_spec buttons[] = {
+	DT_FOREACH_CHILD_STATUS_OKAY_SEP(BUTTON_NODE_LIST, BUTTON_GPIO_SPEC, (,))};
+
+static uint32_t events[BUTTON_COUNT];
+static uint32_t last_evt_at[BUTTON_COUNT];
+static enum button_evt_type last_evt[BUTTON_COUNT];
+
+static void debounce_listener_cb(const struct zbus_channel *chan)
+{
+	const struct msg_button_evt *msg = zbus_chan_const_msg(chan);
+
+	if (msg->button >= BUTTON_COUNT || (msg->flags & BUTTON_EVT_FLAG_INITIAL) ||
+	    (msg->evt != BUTTON_EVT_PRESSED && msg->evt != BUTTON_EVT_RELEASED)) {
+		return;
+	}
+
+	events[msg->button]++;
+	last_evt[msg->button] = msg->evt;
+	last_evt_at[msg->button] = k_cycle_get_32();
+}
+
+ZBUS_LISTENER_DEFINE(debounce_lis, debounce_listener_cb);
+
+ZBUS_CHAN_ADD_OBS(chan_button_evt, debounce_lis, 3);
+
+/* Drives every button with the same physical levels; active low, so 0 is pressed. */
+static void set_all(int level)
+{
+	ARRAY_FOR_EACH(buttons, i) {
+		gpio_emul_input_set(buttons[i].port, buttons[i].pin, level);
+	}
+}
+
+/* Contact bounce: the pin toggles after each of these gaps, ending on the new level. */
+static const uint16_t bounce_us[] = {0, 150, 80, 400, 120, 900, 60, 1500, 200};
+
+static void bounce_to(int level)
+{
+	ARRAY_FOR_EACH(bounce_us, i) {
+		k_busy_wait(bounce_us[i]);
+		set_all((i & 1) ? !level : level);
+	}
+}
+
+static void *debounce_setup(void)
+{
+	set_all(1);
+	k_msleep(SETTLE_MS);
+
+	return NULL;
+}
+
+static void debounce_before(void *f)
+{
+	ARG_UNUSED(f);
+
+	set_all(1);
+	k_msleep(SETTLE_MS);
+	memset(events, 0, sizeof(events));
+}
+
+ZTEST(button_debounce, test_01_bounce_reports_once)
+{
+	bounce_to(0);
+	k_msleep(SETTLE_MS);
+
+	ARRAY_FOR_EACH(buttons, i) {
+		zassert_equal(events[i], 1, "button %d: %u events", i, events[i]);
+		zassert_equal(last_evt[i], BUTTON_EVT_PRESSED);
+		zassert_true(button_is_pressed(i));
+	}
+
+	bounce_to(1);
+	k_msleep(SETTLE_MS);
+
+	ARRAY_FOR_EACH(buttons, i) {
+		zassert_equal(events[i], 2, "button %d: %u events", i, events[i]);
+		zassert_equal(last_evt[i], BUTTON_EVT_RELEASED);
+	}
+}
+
+ZTEST(button_debounce, test_02_glitch_rejected)
+{
+	set_all(0);
+	k_busy_wait(GLITCH_REJECT_US / 2);
+	set_all(1);
+	k_msleep(SETTLE_MS);
+
+	ARRAY_FOR_EACH(buttons, i) {
+		if (i == EAGER) {
+			/* Reported as a press, and released once the lockout ends. */
+			zassert_equal(events[i], 2);
+			zassert_equal(last_evt[i], BUTTON_EVT_RELEASED);
+			continue;
+		}
+		zassert_equal(events[i], 0, "button %d: %u events", i, events[i]);
+	}
+}
+
+ZTEST(button_debounce, test_03_settle_times)
+{
+	uint32_t start;
+
+	start = k_cycle_get_32();
+	set_all(0);
+	k_msleep(SETTLE_MS);
+
+	/* Settle timer and integrator wait debounce_ms; the vote needs 6 samples of 2 ms. */
+	zassert_between_inclusive(k_cyc_to_ms_near32(last_evt_at[SETTLE] - start),
+				  BUTTON_DEBOUNCE_MS_DEFAULT, BUTTON_DEBOUNCE_MS_DEFAULT + 10);
+	zassert_between_inclusive(k_cyc_to_ms_near32(last_evt_at[INTEGRATOR] - start),
+				  BUTTON_DEBOUNCE_MS_DEFAULT - 1, BUTTON_DEBOUNCE_MS_DEFAULT + 10);
+	zassert_between_inclusive(k_cyc_to_ms_near32(last_evt_at[MAJORITY] - start), 10, 20);
+}
+
+ZTEST(button_debounce, test_04_eager_latency)
+{
+	uint32_t start;
+	uint32_t lat_us;
+
+	start = k_cycle_get_32();
+	set_all(0);
+
+	/* Published from the emulated GPIO interrupt, before the pin write returns. */
+	zassert_equal(events[EAGER], 1);
+	lat_us = k_cyc_to_us_ceil32(last_evt_at[EAGER] - start);
+	zassert_true(lat_us < 1000, "eager press after %u us", lat_us);
+
+	k_msleep(SETTLE_MS);
+
+	lat_us = k_cyc_to_us_ceil32(last_evt_at[EAGER_GR] - start);
+	zassert_between_inclusive(lat_us, GLITCH_REJECT_US, GLITCH_REJECT_US + 2000,
+				  "glitch-rejecting press after %u us", lat_us);
+}
+
+ZTEST(button_debounce, test_05_eager_lockout)
+{
+	/* A release inside the lockout window is reported when the window ends. */
+	set_all(0);
+	k_msleep(BUTTON_DEBOUNCE_MS_DEFAULT / 3);
+	set_all(1);
+
+	zassert_equal(events[EAGER], 1);
+	zassert_equal(last_evt[EAGER], BUTTON_EVT_PRESSED);
+
+	k_msleep(BUTTON_DEBOUNCE_MS_DEFAULT);
+
+	zassert_equal(events[EAGER], 2);
+	zassert_equal(last_evt[EAGER], BUTTON_EVT_RELEASED);
+	zassert_false(button_is_pressed(EAGER));
+}
+
+ZTEST_SUITE(button_debounce, NULL, debounce_setup, debounce_before, NULL, NULL);
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2025 Rodrigo Peixoto <rodrigopex@ic.ufal.br>
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stdlib.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/drivers/gpio/gpio_emul.h>
+
+#include "button.h"
+#include "encoder.h"
+
+ZBUS_MSG_SUBSCRIBER_DEFINE(msub_encoder_evt);
+
+ZBUS_CHAN_ADD_OBS(chan_encoder_evt, msub_encoder_evt, 3);
+
+static const struct gpio_dt_spec phase_a = GPIO_DT_SPEC_GET_BY_IDX(DT_ALIAS(qdec0), gpios, 0);
+static const struct gpio_dt_spec phase_b = GPIO_DT_SPEC_GET_BY_IDX(DT_ALIAS(qdec0), gpios, 1);
+
+/* Clockwise phase states (A << 1 | B) after 00. */
+static const uint8_t cw_sequence[] = {0x2, 0x3, 0x1, 0x0};
+
+static void phase_set(uint8_t ab)
+{
+	gpio_emul_input_set(phase_a.port, phase_a.pin, (ab >> 1) & 1);
+	gpio_emul_input_set(phase_b.port, phase_b.pin, ab & 1);
+}
+
+static void turn(int detents, uint32_t step_us)
+{
+	for (int d = 0; d < abs(detents); d++) {
+		for (int i = 0; i < ARRAY_SIZE(cw_sequence); i++) {
+			int idx = detents > 0 ? i : ARRAY_SIZE(cw_sequence) - 2 - i;
+
+			/* Counter-clockwise walks the sequence backwards and ends on 00. */
+			phase_set(idx < 0 ? 0x0 : cw_sequence[idx]);
+			k_busy_wait(step_us);
+		}
+	}
+}
+
+static int32_t collect(int *events)
+{
+	const struct zbus_channel *chan;
+	struct msg_encoder_evt msg;
+	int32_t total = 0;
+
+	*events = 0;
+	while (zbus_sub_wait_msg(&msub_encoder_evt, &chan, &msg,
+				 K_MSEC(3 * CONFIG_ENCODER_PUBLISH_INTERVAL_MS)) == 0) {
+		total += msg.detents;
+		(*events)++;
+	}
+
+	return total;
+}
+
+static void *encoder_setup(void)
+{
+	phase_set(0x0);
+	zassert_ok(encoder_init());
+
+	return NULL;
+}
+
+static void encoder_before(void *f)
+{
+	int events;
+
+	phase_set(0x0);
+	(void)collect(&events);
+}
+
+ZTEST(encoder, test_01_single_detent_each_way)
+{
+	const struct zbus_channel *chan;
+	struct msg_encoder_evt msg;
+
+	turn(1, 500);
+	zassert_ok(zbus_sub_wait_msg(&msub_encoder_evt, &chan, &msg, K_MSEC(100)));
+	zassert_equal(msg.detents, 1);
+	zassert_true(msg.velocity > 0);
+
+	turn(-1, 500);
+	zassert_ok(zbus_sub_wait_msg(&msub_encoder_evt, &chan, &msg, K_MSEC(100)));
+	zassert_equal(msg.detents, -1);
+	zassert_true(msg.velocity < 0);
+}
+
+ZTEST(encoder, test_02_contact_bounce_cancels_out)
+{
+	int events;
+
+	/* A chatters around 00 <-> 10 without completing a detent. */
+	for (int i = 0; i < 10; i++) {
+		phase_set(0x2);
+		phase_set(0x0);
+	}
+
+	zassert_equal(collect(&events), 0);
+	zassert_equal(events, 0);
+}
+
+ZTEST(encoder, test_03_fast_spin_is_rate_limited)
+{
+	uint32_t start = k_uptime_get_32();
+	uint32_t duration;
+	int events;
+
+	turn(40, 100);
+	duration = k_uptime_get_32() - start;
+
+	zassert_equal(collect(&events), 40);
+	zassert_true(events <= duration / CONFIG_ENCODER_PUBLISH_INTERVAL_MS + 2,
+		     "%d events in %u ms", events, duration);
+}
+
+ZTEST(encoder, test_04_invalid_transition_ignored)
+{
+	uint32_t before = encoder_invalid_transitions();
+	int events;
+
+	/* Both phases flip in a single port write, as after a missed interrupt. */
+	gpio_emul_input_set_masked(phase_a.port, BIT(phase_a.pin) | BIT(phase_b.pin),
+				   BIT(phase_a.pin) | BIT(phase_b.pin));
+	gpio_emul_input_set_masked(phase_a.port, BIT(phase_a.pin) | BIT(phase_b.pin), 0);
+
+	zassert_equal(collect(&events), 0);
+	zassert_true(encoder_invalid_transitions() > before);
+}
+
+ZTEST(encoder, test_05_first_detent_after_idle_not_delayed)
+{
+	const struct zbus_channel *chan;
+	struct msg_encoder_evt msg;
+	uint32_t first_at;
+	uint32_t second_at;
+
+	/* encoder_before() left the encoder idle for longer than the interval. */
+	turn(1, 100);
+	zassert_ok(zbus_sub_wait_msg(&msub_encoder_evt, &chan, &msg, K_MSEC(100)));
+	first_at = k_cycle_get_32();
+	zassert_true(k_cyc_to_us_floor32(first_at - msg.timestamp) <
+			     CONFIG_ENCODER_PUBLISH_INTERVAL_MS * USEC_PER_MSEC / 2,
+		     "first detent delayed by %u us", k_cyc_to_us_floor32(first_at - msg.timestamp));
+
+	/* The next one falls inside the interval and waits for its end. */
+	turn(1, 100);
+	zassert_ok(zbus_sub_wait_msg(&msub_encoder_evt, &chan, &msg, K_MSEC(100)));
+	second_at = k_cycle_get_32();
+	zassert_equal(msg.detents, 1);
+	zassert_true(k_cyc_to_ms_floor32(second_at - first_at) >=
+			     CONFIG_ENCODER_PUBLISH_INTERVAL_MS - 1,
+		     "second event %u ms after the first", k_cyc_to_ms_floor32(second_at - first_at));
+}
+
+ZTEST_SUITE(encoder, NULL, encoder_setup, encoder_before, NULL, NULL);
@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2025 Rodrigo Peixoto <rodrigopex@ic.ufal.br>
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/irq.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/drivers/gpio/gpio_emul.h>
+
+#include "button.h"
+#include "button_time.h"
+
+/*
+ * libFuzzer harness for the button pipeline on native_sim/native/64. Each input is a script of
+ * 2-byte steps: byte 0 selects the button (low bits) and the physical pin level (bit 7), byte 1
+ * is the delay before the next step in 250 us units. Every input starts with all buttons released
+ * and a fresh model, so a saved input reproduces on its own. The script is replayed through
+ * gpio-emul, every button is then released, and a listener checks these invariants throughout:
+ *
+ * - PRESSED and RELEASED alternate per button, starting from the initial state event;
+ * - LONGPRESS directly follows a RELEASED whose press lasted at least the threshold;
+ * - REPEAT only while the button is held;
+ * - timestamps never go backwards per button;
+ * - after the final release every button is released.
+ *
+ * A violation asserts, which libFuzzer reports as a crash and saves the input under its
+ * -artifact_prefix; tests/fuzz/regressions keeps those traces for replay.
+ */
+
+#define MAX_STEPS 128
+#define SETTLE_MS (4 * BUTTON_DEBOUNCE_MS_DEFAULT)
+
+#define BUTTON_GPIO_SPEC(node) GPIO_DT_SPEC_GET(node, gpios),
+
+static const struct gpio_dt_spec buttons[] = {
+	DT_FOREACH_CHILD_STATUS_OKAY(BUTTON_NODE_LIST, BUTTON_GPIO_SPEC)};
+
+extern const uint8_t *posix_fuzz_buf;
+extern size_t posix_fuzz_sz;
+
+static K_SEM_DEFINE(fuzz_sem, 0, 1);
+
+struct button_model {
+	bool pressed;
+	bool seen;
+	enum button_evt_type last_evt;
+	uint32_t pressed_at;
+	uint32_t last_timestamp;
+	uint32_t held_ms;
+};
+
+static struct button_model model[BUTTON_COUNT];
+
+static void invariant_listener_cb(const struct zbus_channel *chan)
+{
+	const struct msg_button_evt *msg = zbus_chan_const_msg(chan);
+	struct button_model *m;
+
+	__ASSERT(msg->button < BUTTON_COUNT, "event for unknown button %u", msg->button);
+	m = &model[msg->button];
+
+	__ASSERT(!m->seen || (int32_t)(msg->timestamp - m->last_timestamp) >= 0,
+		 "button %u: timestamp went backwards", msg->button);
+	m->last_timestamp = msg->timestamp;
+
+	if (msg->flags & BUTTON_EVT_FLAG_INITIAL) {
+		__ASSERT(!m->seen, "button %u: initial event after start", msg->button);
+		m->pressed = msg->evt == BUTTON_EVT_PRESSED;
+		m->pressed_at = msg->timestamp;
+		m->seen = true;
+		m->last_evt = msg->evt;
+		return;
+	}
+
+	__ASSERT(m->seen, "button %u: event before the initial state", msg->button);
+
+	switch (msg->evt) {
+	case BUTTON_EVT_PRESSED:
+		__ASSERT(!m->pressed, "button %u: PRESSED twice", msg->button);
+		m->pressed = true;
+		m->pressed_at = msg->timestamp;
+		break;
+	case BUTTON_EVT_RELEASED:
+		__ASSERT(m->pressed, "button %u: RELEASED without PRESSED", msg->button);
+		m->pressed = false;
+		m->held_ms = button_cyc_to_ms(msg->timestamp - m->pressed_at);
+		__ASSERT(msg->held_ms == m->held_ms, "button %u: RELEASED says %u ms, held %u ms",
+			 msg->button, msg->held_ms, m->held_ms);
+		break;
+	case BUTTON_EVT_LONGPRESS:
+		__ASSERT(m->last_evt == BUTTON_EVT_RELEASED,
+			 "button %u: LONGPRESS not after release", msg->button);
+		__ASSERT(m->held_ms >= CONFIG_BUTTON_LONG_PRESS_MS,
+			 "button %u: LONGPRESS after %u ms", msg->button, m->held_ms);
+		break;
+	case BUTTON_EVT_REPEAT:
+		__ASSERT(m->pressed, "button %u: REPEAT while released", msg->button);
+		break;
+	case BUTTON_EVT_HOLD:
+		__ASSERT(m->pressed, "button %u: HOLD while released", msg->button);
+		break;
+	default:
+		__ASSERT(false, "button %u: unexpected event %d", msg->button, msg->evt);
+		break;
+	}
+
+	m->last_evt = msg->evt;
+}
+
+ZBUS_LISTENER_DEFINE(invariant_lis, invariant_listener_cb);
+
+ZBUS_CHAN_ADD_OBS(chan_button_evt, invariant_lis, 3);
+
+static void button_set(uint8_t idx, bool level)
+{
+	gpio_emul_input_set(buttons[idx].port, buttons[idx].pin, level);
+}
+
+static void release_all(void)
+{
+	/* Physically release everything; logical level depends on the pin's active level. */
+	ARRAY_FOR_EACH(buttons, i) {
+		button_set(i, (buttons[i].dt_flags & GPIO_ACTIVE_LOW) ? 1 : 0);
+	}
+	k_msleep(SETTLE_MS);
+}
+
+/* Forgets what earlier inputs did; the pipeline has settled with every button released. */
+static void model_reset(void)
+{
+	ARRAY_FOR_EACH(model, i) {
+		model[i] = (struct button_model){
+			.seen = true,
+			.last_evt = BUTTON_EVT_UNDEFINED,
+			.last_timestamp = k_cycle_get_32(),
+		};
+	}
+}
+
+static void replay(const uint8_t *data, size_t size)
+{
+	size_t steps = MIN(size / 2, MAX_STEPS);
+
+	release_all();
+	model_reset();
+
+	for (size_t i = 0; i < steps; i++) {
+		uint8_t op = data[2 * i];
+
+		button_set((op & 0x7f) % BUTTON_COUNT, op >> 7);
+		k_usleep(data[2 * i + 1] * 250);
+	}
+
+	release_all();
+
+	ARRAY_FOR_EACH(model, i) {
+		__ASSERT(!model[i].pressed, "button %d still pressed after release", i);
+	}
+}
+
+static void fuzz_isr(const void *arg)
+{
+	/* Run the case from a thread so timers and workqueues get to execute. */
+	k_sem_give(&fuzz_sem);
+}
+
+int main(void)
+{
+	static uint8_t script[2 * MAX_STEPS];
+
+	IRQ_CONNECT(CONFIG_ARCH_POSIX_FUZZ_IRQ, 0, fuzz_isr, NULL, 0);
+	irq_enable(CONFIG_ARCH_POSIX_FUZZ_IRQ);
+
+	while (true) {
+		size_t size;
+
+		k_sem_take(&fuzz_sem, K_FOREVER);
+
+		/* The buffer is only valid while the case runs; keep a copy. */
+		size = MIN(posix_fuzz_sz, sizeof(script));
+		memcpy(script, posix_fuzz_buf, size);
+
+		replay(script, size);
+	}
+
+	return 0;
+}
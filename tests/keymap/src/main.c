@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2025 Rodrigo Peixoto <rodrigopex@ic.ufal.br>
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/drivers/gpio/gpio_emul.h>
+
+#include "button.h"
+#include "button_keymap.h"
+
+ZBUS_MSG_SUBSCRIBER_DEFINE(msub_button_action);
+
+ZBUS_CHAN_ADD_OBS(chan_button_action, msub_button_action, 3);
+
+static const struct gpio_dt_spec front = GPIO_DT_SPEC_GET(DT_NODELABEL(front_button), gpios);
+
+static void publish(enum button_evt_type evt, uint8_t button, uint8_t flags)
+{
+	struct msg_button_evt msg = {.evt = evt, .button = button, .flags = flags};
+
+	zassert_ok(zbus_chan_pub(&chan_button_evt, &msg, K_MSEC(100)));
+}
+
+static void keymap_before(void *f)
+{
+	const struct zbus_channel *chan;
+	struct msg_button_action msg;
+
+	ARG_UNUSED(f);
+
+	k_msleep(2 * BUTTON_DEBOUNCE_MS_DEFAULT);
+	while (zbus_sub_wait_msg(&msub_button_action, &chan, &msg, K_NO_WAIT) == 0) {
+	}
+}
+
+ZTEST(button_keymap, test_01_lookup_matches_devicetree)
+{
+	zassert_equal(button_keymap_lookup(0, BUTTON_EVT_PRESSED), 1);
+	zassert_equal(button_keymap_lookup(0, BUTTON_EVT_LONGPRESS), 2);
+	zassert_equal(button_keymap_lookup(1, BUTTON_EVT_PRESSED), 3);
+	zassert_equal(button_keymap_lookup(1, BUTTON_EVT_REPEAT), BUTTON_ACTION_MAX);
+
+	zassert_equal(button_keymap_lookup(0, BUTTON_EVT_RELEASED), BUTTON_ACTION_NONE);
+	zassert_equal(button_keymap_lookup(1, BUTTON_EVT_LONGPRESS), BUTTON_ACTION_NONE);
+	zassert_equal(button_keymap_lookup(BUTTON_COUNT, BUTTON_EVT_PRESSED), BUTTON_ACTION_NONE);
+	zassert_equal(button_keymap_lookup(0, BUTTON_EVT_TYPE_COUNT), BUTTON_ACTION_NONE);
+}
+
+ZTEST(button_keymap, test_02_press_publishes_action)
+{
+	const struct zbus_channel *chan;
+	struct msg_button_action msg = {0};
+
+	gpio_emul_input_set(front.port, front.pin, 1);
+	k_msleep(2 * BUTTON_DEBOUNCE_MS_DEFAULT);
+	gpio_emul_input_set(front.port, front.pin, 0);
+
+	zassert_ok(zbus_sub_wait_msg(&msub_button_action, &chan, &msg, K_SECONDS(1)));
+	zassert_equal(chan, &chan_button_action);
+	zassert_equal(msg.action, 1);
+	zassert_equal(msg.button, 0);
+	zassert_equal(msg.evt, BUTTON_EVT_PRESSED);
+
+	gpio_emul_input_set(front.port, front.pin, 1);
+
+	/* RELEASED is unmapped, and a short press has no LONGPRESS. */
+	zassert_equal(zbus_sub_wait_msg(&msub_button_action, &chan, &msg, K_MSEC(200)), -ENOMSG);
+}
+
+ZTEST(button_keymap, test_03_unmapped_and_initial_are_dropped)
+{
+	const struct zbus_channel *chan;
+	struct msg_button_action msg;
+
+	publish(BUTTON_EVT_RELEASED, 0, 0);
+	publish(BUTTON_EVT_LONGPRESS, 1, 0);
+	publish(BUTTON_EVT_PRESSED, 1, BUTTON_EVT_FLAG_INITIAL);
+
+	zassert_equal(zbus_sub_wait_msg(&msub_button_action, &chan, &msg, K_MSEC(100)), -ENOMSG);
+
+	publish(BUTTON_EVT_PRESSED, 1, 0);
+
+	zassert_ok(zbus_sub_wait_msg(&msub_button_action, &chan, &msg, K_MSEC(100)));
+	zassert_equal(msg.action, 3);
+	zassert_equal(msg.button, 1);
+}
+
+ZTEST_SUITE(button_keymap, NULL, NULL, keymap_before, NULL, NULL);
+
+#define FRONT 0
+#define BACK  1
+#define FN    2
+
+static uint16_t next_action(void)
+{
+	const struct zbus_channel *chan;
+	struct msg_button_action msg;
+
+	if (zbus_sub_wait_msg(&msub_button_action, &chan, &msg, K_MSEC(100)) != 0) {
+		return BUTTON_ACTION_NONE;
+	}
+
+	return msg.action;
+}
+
+static void layers_before(void *f)
+{
+	keymap_before(f);
+
+	zassert_equal(button_keymap_layers(), BIT(0), "layer left active by a previous test");
+}
+
+ZTEST(button_keymap_layers, test_01_momentary)
+{
+	publish(BUTTON_EVT_PRESSED, FN, 0);
+	zassert_equal(button_keymap_layers(), BIT(0) | BIT(1));
+	/* Layer switches are consumed. */
+	zassert_equal(next_action(), BUTTON_ACTION_NONE);
+
+	publish(BUTTON_EVT_PRESSED, FRONT, 0);
+	zassert_equal(next_action(), 10);
+	publish(BUTTON_EVT_RELEASED, FRONT, 0);
+	zassert_equal(next_action(), 11);
+
+	/* Falls through to layer 0. */
+	publish(BUTTON_EVT_PRESSED, BACK, 0);
+	zassert_equal(next_action(), 3);
+	publish(BUTTON_EVT_RELEASED, BACK, 0);
+
+	publish(BUTTON_EVT_RELEASED, FN, 0);
+	zassert_equal(button_keymap_layers(), BIT(0));
+
+	publish(BUTTON_EVT_PRESSED, FRONT, 0);
+	zassert_equal(next_action(), 1);
+	publish(BUTTON_EVT_RELEASED, FRONT, 0);
+	zassert_equal(next_action(), BUTTON_ACTION_NONE);
+}
+
+ZTEST(button_keymap_layers, test_02_layer_key_released_first)
+{
+	publish(BUTTON_EVT_PRESSED, FN, 0);
+	publish(BUTTON_EVT_PRESSED, FRONT, 0);
+	zassert_equal(next_action(), 10);
+
+	publish(BUTTON_EVT_RELEASED, FN, 0);
+	zassert_equal(button_keymap_layers(), BIT(0));
+
+	/* The rest of the press still resolves on the layer it started on... */
+	publish(BUTTON_EVT_RELEASED, FRONT, 0);
+	zassert_equal(next_action(), 11);
+	/* ...falling through to layer 0 where that layer has no entry. */
+	publish(BUTTON_EVT_LONGPRESS, FRONT, 0);
+	zassert_equal(next_action(), 2);
+}
+
+ZTEST(button_keymap_layers, test_03_layer_key_pressed_during_press)
+{
+	publish(BUTTON_EVT_PRESSED, FRONT, 0);
+	zassert_equal(next_action(), 1);
+
+	publish(BUTTON_EVT_PRESSED, FN, 0);
+
+	/* Pressed on layer 0, where RELEASED is unmapped. */
+	publish(BUTTON_EVT_RELEASED, FRONT, 0);
+	zassert_equal(next_action(), BUTTON_ACTION_NONE);
+
+	publish(BUTTON_EVT_RELEASED, FN, 0);
+	zassert_equal(button_keymap_layers(), BIT(0));
+}
+
+ZTEST(button_keymap_layers, test_04_toggle_and_stack)
+{
+	/* A long press of FN holds layer 1 until released, then toggles layer 2. */
+	publish(BUTTON_EVT_PRESSED, FN, 0);
+	publish(BUTTON_EVT_RELEASED, FN, 0);
+	publish(BUTTON_EVT_LONGPRESS, FN, 0);
+	zassert_equal(button_keymap_layers(), BIT(0) | BIT(2));
+
+	publish(BUTTON_EVT_PRESSED, BACK, 0);
+	zassert_equal(next_action(), 21);
+	publish(BUTTON_EVT_RELEASED, BACK, 0);
+
+	/* Both layers active: the highest one wins. */
+	publish(BUTTON_EVT_PRESSED, FN, 0);
+	zassert_equal(button_keymap_layers(), BIT(0) | BIT(1) | BIT(2));
+	publish(BUTTON_EVT_PRESSED, FRONT, 0);
+	zassert_equal(next_action(), 20);
+	/* Layer 2 has no RELEASED for FRONT, layer 1 has. */
+	publish(BUTTON_EVT_RELEASED, FRONT, 0);
+	zassert_equal(next_action(), 11);
+	publish(BUTTON_EVT_RELEASED, FN, 0);
+
+	/* Toggled off again from layer 2 itself. */
+	publish(BUTTON_EVT_PRESSED, FN, 0);
+	publish(BUTTON_EVT_RELEASED, FN, 0);
+	publish(BUTTON_EVT_LONGPRESS, FN, 0);
+	zassert_equal(button_keymap_layers(), BIT(0));
+
+	publish(BUTTON_EVT_PRESSED, BACK, 0);
+	zassert_equal(next_action(), 3);
+	publish(BUTTON_EVT_RELEASED, BACK, 0);
+}
+
+ZTEST_SUITE(button_keymap_layers, NULL, NULL, layers_before, NULL, NULL);
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2025 Rodrigo Peixoto <rodrigopex@ic.ufal.br>
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/drivers/gpio/gpio_emul.h>
+
+#include "led_bcm.h"
+
+#define LED_GPIO_SPEC(node) GPIO_DT_SPEC_GET(node, gpios)
+
+static const struct gpio_dt_spec leds[] = {
+	DT_FOREACH_CHILD_STATUS_OKAY_SEP(LED_NODE_LIST, LED_GPIO_SPEC, (,))};
+
+/* Planes 1, 2, 4, ... times the shortest one: a frame is LED_BCM_LEVELS - 1 of them. */
+#define FRAME_US ((LED_BCM_LEVELS - 1) * CONFIG_LED_BCM_BIT0_US)
+
+static int raw_get(uint8_t led)
+{
+	return gpio_emul_output_get(leds[led].port, leds[led].pin);
+}
+
+static void all_off(void)
+{
+	ARRAY_FOR_EACH(leds, i) {
+		zassert_ok(led_bcm_set(i, 0));
+	}
+}
+
+static void *led_bcm_setup(void)
+{
+	zassert_ok(led_bcm_init());
+
+	return NULL;
+}
+
+static void led_bcm_before(void *f)
+{
+	all_off();
+}
+
+ZTEST(led_bcm, test_01_invalid_arguments)
+{
+	zassert_equal(led_bcm_set(LED_COUNT, 0), -EINVAL);
+	zassert_equal(led_bcm_set(0, LED_BCM_LEVELS), -EINVAL);
+}
+
+ZTEST(led_bcm, test_02_static_levels_stop_the_timer)
+{
+	uint32_t wakeups;
+
+	zassert_ok(led_bcm_set(0, LED_BCM_LEVELS - 1));
+	zassert_ok(led_bcm_set(1, LED_BCM_LEVELS - 1));
+
+	/* led_1 is active low; led_2 sits on another port and stays off. */
+	zassert_equal(raw_get(0), 1);
+	zassert_equal(raw_get(1), 0);
+	zassert_equal(raw_get(2), 0);
+
+	wakeups = led_bcm_wakeups();
+	k_msleep(10 * FRAME_US / USEC_PER_MSEC);
+	zassert_true(led_bcm_wakeups() - wakeups <= 1, "timer ran with no LED dimmed");
+
+	all_off();
+	zassert_equal(raw_get(0), 0);
+	zassert_equal(raw_get(1), 1);
+}
+
+ZTEST(led_bcm, test_03_one_wakeup_per_bit)
+{
+	uint32_t start = k_uptime_get_32();
+	uint32_t wakeups = led_bcm_wakeups();
+	uint32_t frames;
+	uint32_t elapsed;
+
+	/* Dimming every LED costs the same as dimming one. */
+	ARRAY_FOR_EACH(leds, i) {
+		zassert_ok(led_bcm_set(i, 1 + i));
+	}
+	k_msleep(20 * FRAME_US / USEC_PER_MSEC);
+
+	elapsed = k_uptime_get_32() - start;
+	wakeups = led_bcm_wakeups() - wakeups;
+	frames = elapsed * USEC_PER_MSEC / FRAME_US;
+
+	zassert_between_inclusive(wakeups, (frames - 1) * CONFIG_LED_BCM_BITS,
+				  (frames + 1) * CONFIG_LED_BCM_BITS, "%u wakeups in %u ms", wakeups,
+				  elapsed);
+}
+
+ZTEST(led_bcm, test_04_duty_cycle)
+{
+	uint8_t levels[] = {1, LED_BCM_LEVELS / 2, LED_BCM_LEVELS - 2};
+
+	ARRAY_FOR_EACH(levels, l) {
+		uint32_t end;
+		uint32_t on = 0;
+		uint32_t samples = 0;
+
+		zassert_ok(led_bcm_set(2, levels[l]));
+		k_msleep(FRAME_US / USEC_PER_MSEC + 1);
+
+		end = k_uptime_get_32() + 50 * FRAME_US / USEC_PER_MSEC;
+		while ((int32_t)(k_uptime_get_32() - end) < 0) {
+			on += raw_get(2);
+			samples++;
+			k_busy_wait(7);
+		}
+
+		/* Within 5% of full scale, for sampling and timer jitter. */
+		zassert_within((int)(on * 100 / samples), levels[l] * 100 / (LED_BCM_LEVELS - 1), 5,
+			       "level %u: on %u of %u samples", levels[l], on, samples);
+	}
+}
+
+ZTEST_SUITE(led_bcm, NULL, led_bcm_setup, led_bcm_before, NULL, NULL);
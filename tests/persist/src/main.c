@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2025 Rodrigo Peixoto <rodrigopex@ic.ufal.br>
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/storage/flash_map.h>
+
+#include "button.h"
+#include "button_persist.h"
+
+#define PRESSES 1000
+
+static void publish(enum button_evt_type evt)
+{
+	struct msg_button_evt msg = {.evt = evt, .button = 0, .timestamp = k_cycle_get_32()};
+
+	zassert_ok(zbus_chan_pub(&chan_button_evt, &msg, K_MSEC(100)));
+}
+
+static void count_entries(const struct button_log_entry *entry, void *user_data)
+{
+	uint32_t *count = user_data;
+
+	zassert_equal(entry->button, 0);
+	zassert_true(entry->evt == BUTTON_EVT_PRESSED || entry->evt == BUTTON_EVT_LONGPRESS);
+	(*count)++;
+}
+
+ZTEST(persist, test_00_init_retried_after_failure)
+{
+	const struct device *flash = FIXED_PARTITION_DEVICE(storage_partition);
+
+	/* An unready flash fails button_init(), which must not stay latched as initialised. */
+	flash->state->initialized = false;
+	zassert_equal(button_init(), -ENODEV);
+	flash->state->initialized = true;
+
+	/* The button reads as held, so init publishes an initial PRESSED the counters ignore. */
+	zassert_ok(button_init());
+}
+
+ZTEST(persist, test_01_writes_per_thousand_presses)
+{
+	struct button_persist_counters counters;
+	uint32_t writes;
+
+	for (int i = 0; i < PRESSES; i++) {
+		publish(BUTTON_EVT_PRESSED);
+		publish(BUTTON_EVT_RELEASED);
+	}
+
+	/* Let the flush work run, then write the remainder. */
+	k_msleep(100);
+	zassert_ok(button_persist_flush());
+
+	writes = button_persist_write_count();
+	TC_PRINT("flash writes per %d presses: %u\n", PRESSES, writes);
+
+	/* One counters record and one log record per batch, plus the final partial batch. */
+	zassert_true(writes <= 2 * (PRESSES / CONFIG_BUTTON_PERSIST_FLUSH_PRESSES + 1));
+
+	zassert_ok(button_persist_counters_get(0, &counters));
+	zassert_equal(counters.presses, PRESSES);
+	zassert_equal(button_persist_log_dropped(), 0);
+}
+
+ZTEST(persist, test_02_counters_survive_remount)
+{
+	struct button_persist_counters before;
+	struct button_persist_counters after;
+
+	/* REPEAT and HOLD are not logged; test_03 checks what the log holds. */
+	publish(BUTTON_EVT_PRESSED);
+	publish(BUTTON_EVT_REPEAT);
+	publish(BUTTON_EVT_HOLD);
+	publish(BUTTON_EVT_RELEASED);
+	publish(BUTTON_EVT_LONGPRESS);
+	zassert_ok(button_persist_flush());
+
+	zassert_ok(button_persist_counters_get(0, &before));
+	zassert_ok(button_persist_init());
+	zassert_ok(button_persist_counters_get(0, &after));
+
+	zassert_equal(before.presses, after.presses);
+	zassert_equal(before.long_presses, after.long_presses);
+	zassert_true(after.long_presses >= 1);
+}
+
+ZTEST(persist, test_03_log_keeps_newest_records)
+{
+	uint32_t count = 0;
+
+	zassert_ok(button_persist_log_foreach(count_entries, &count));
+
+	zassert_true(count > 0);
+	zassert_true(count <= CONFIG_BUTTON_PERSIST_LOG_RECORDS * CONFIG_BUTTON_PERSIST_LOG_BATCH);
+}
+
+ZTEST_SUITE(persist, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) 2025 Rodrigo Peixoto <rodrigopex@ic.ufal.br>
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/random/random.h>
+#include <zephyr/drivers/gpio/gpio_emul.h>
+
+#include "button.h"
+#include "button_priv.h"
+
+/*
+ * Hammers every button from one thread per CPU while a listener checks that each button's
+ * events alternate PRESSED/RELEASED with non-decreasing timestamps. Buttons 2 and 3 are eager,
+ * so their edges reach the core from the hammering threads' own CPUs. A second test calls
+ * button_core_report() from every thread, each owning a share of the buttons as a backend would,
+ * and a third does the same with repeat and hold enabled, so releases race the handlers.
+ */
+
+#define HAMMER_THREADS    CONFIG_MP_MAX_NUM_CPUS
+#define HAMMER_EDGES      2000
+#define HAMMER_STACK_SIZE 1024
+#define SETTLE_MS         (DT_PROP(BUTTON_NODE_LIST, debounce_interval_ms) * 4)
+
+#define BUTTON_GPIO_SPEC(node) GPIO_DT_SPEC_GET(node, gpios)
+
+static const struct gpio_dt_spec buttons[] = {
+	DT_FOREACH_CHILD_STATUS_OKAY_SEP(BUTTON_NODE_LIST, BUTTON_GPIO_SPEC, (,))};
+
+static K_THREAD_STACK_ARRAY_DEFINE(hammer_stacks, HAMMER_THREADS, HAMMER_STACK_SIZE);
+static struct k_thread hammer_threads[HAMMER_THREADS];
+
+static bool seen_pressed[BUTTON_COUNT];
+static uint32_t last_timestamp[BUTTON_COUNT];
+static uint32_t observed_presses[BUTTON_COUNT];
+static uint32_t observed_releases[BUTTON_COUNT];
+static atomic_t violations;
+
+static atomic_t in_core;
+static atomic_t max_in_core;
+
+static void invariant_listener_cb(const struct zbus_channel *chan)
+{
+	const struct msg_button_evt *msg = zbus_chan_const_msg(chan);
+	uint8_t idx = msg->button;
+
+	if (idx >= BUTTON_COUNT) {
+		atomic_inc(&violations);
+		return;
+	}
+
+	if ((int32_t)(msg->timestamp - last_timestamp[idx]) < 0) {
+		atomic_inc(&violations);
+	}
+	last_timestamp[idx] = msg->timestamp;
+
+	/* Initial events report the level sampled at boot; only a held button counts a press. */
+	if (msg->flags & BUTTON_EVT_FLAG_INITIAL) {
+		seen_pressed[idx] = msg->evt == BUTTON_EVT_PRESSED;
+		observed_presses[idx] += seen_pressed[idx];
+		return;
+	}
+
+	switch (msg->evt) {
+	case BUTTON_EVT_PRESSED:
+		if (seen_pressed[idx]) {
+			atomic_inc(&violations);
+		}
+		seen_pressed[idx] = true;
+		observed_presses[idx]++;
+		break;
+	case BUTTON_EVT_RELEASED:
+		if (!seen_pressed[idx]) {
+			atomic_inc(&violations);
+		}
+		seen_pressed[idx] = false;
+		observed_releases[idx]++;
+		break;
+	case BUTTON_EVT_LONGPRESS:
+		if (seen_pressed[idx]) {
+			atomic_inc(&violations);
+		}
+		break;
+	case BUTTON_EVT_REPEAT:
+	case BUTTON_EVT_HOLD:
+		if (!seen_pressed[idx]) {
+			atomic_inc(&violations);
+		}
+		break;
+	default:
+		atomic_inc(&violations);
+		break;
+	}
+}
+
+ZBUS_LISTENER_DEFINE(invariant_lis, invariant_listener_cb);
+
+ZBUS_CHAN_ADD_OBS(chan_button_evt, invariant_lis, 3);
+
+static void hammer(void *p1, void *p2, void *p3)
+{
+	for (int i = 0; i < HAMMER_EDGES; i++) {
+		const struct gpio_dt_spec *button = &buttons[sys_rand32_get() % BUTTON_COUNT];
+
+		gpio_emul_input_set(button->port, button->pin, sys_rand32_get() & 1);
+		k_busy_wait(sys_rand32_get() % 200);
+	}
+}
+
+static void report(uint8_t idx, bool is_pressed)
+{
+	atomic_val_t n = atomic_inc(&in_core) + 1;
+	atomic_val_t max;
+
+	do {
+		max = atomic_get(&max_in_core);
+	} while (n > max && !atomic_cas(&max_in_core, max, n));
+
+	button_core_report(idx, is_pressed);
+	atomic_dec(&in_core);
+}
+
+static void hammer_reports(void *p1, void *p2, void *p3)
+{
+	uint32_t first = POINTER_TO_UINT(p1);
+
+	for (int i = 0; i < HAMMER_EDGES; i++) {
+		uint32_t idx = first + HAMMER_THREADS * (sys_rand32_get() %
+						 DIV_ROUND_UP(BUTTON_COUNT, HAMMER_THREADS));
+
+		if (idx < BUTTON_COUNT) {
+			report(idx, sys_rand32_get() & 1);
+		}
+		k_busy_wait(sys_rand32_get() % 50);
+	}
+
+	for (uint32_t idx = first; idx < BUTTON_COUNT; idx += HAMMER_THREADS) {
+		report(idx, false);
+	}
+}
+
+static void hammer_holds(void *p1, void *p2, void *p3)
+{
+	uint32_t first = POINTER_TO_UINT(p1);
+
+	for (int i = 0; i < HAMMER_EDGES / 10; i++) {
+		for (uint32_t idx = first; idx < BUTTON_COUNT; idx += HAMMER_THREADS) {
+			report(idx, true);
+		}
+		k_busy_wait(sys_rand32_get() % 3000);
+		for (uint32_t idx = first; idx < BUTTON_COUNT; idx += HAMMER_THREADS) {
+			report(idx, false);
+		}
+		k_busy_wait(sys_rand32_get() % 100);
+	}
+}
+
+static void check_invariants(void)
+{
+	zassert_equal(atomic_get(&violations), 0, "%d invariant violations",
+		      (int)atomic_get(&violations));
+	zassert_equal(button_pressed_mask(), 0, "snapshot out of sync with the events");
+
+	ARRAY_FOR_EACH(buttons, i) {
+		struct button_stats stats;
+
+		zassert_ok(button_stats_get(i, &stats));
+		zassert_false(seen_pressed[i], "button %d left pressed", i);
+		zassert_equal(stats.presses, stats.releases);
+		zassert_equal(stats.presses, observed_presses[i]);
+		zassert_equal(stats.releases, observed_releases[i]);
+		TC_PRINT("button %d: %u presses\n", i, stats.presses);
+	}
+}
+
+static void *smp_stress_setup(void)
+{
+	button_init();
+
+	ARRAY_FOR_EACH(buttons, i) {
+		gpio_emul_input_set(buttons[i].port, buttons[i].pin, 1);
+	}
+
+	button_enable_interrupts();
+
+	return NULL;
+}
+
+ZTEST(smp_stress, test_concurrent_edges)
+{
+	for (int i = 0; i < HAMMER_THREADS; i++) {
+		k_thread_create(&hammer_threads[i], hammer_stacks[i],
+				K_THREAD_STACK_SIZEOF(hammer_stacks[i]), hammer, NULL, NULL, NULL,
+				K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	}
+
+	for (int i = 0; i < HAMMER_THREADS; i++) {
+		k_thread_join(&hammer_threads[i], K_FOREVER);
+	}
+
+	/* Release everything and let the debounce windows expire. */
+	ARRAY_FOR_EACH(buttons, i) {
+		gpio_emul_input_set(buttons[i].port, buttons[i].pin, 1);
+	}
+	k_msleep(SETTLE_MS);
+
+	check_invariants();
+}
+
+ZTEST(smp_stress, test_concurrent_reports)
+{
+	for (int i = 0; i < HAMMER_THREADS; i++) {
+		k_thread_create(&hammer_threads[i], hammer_stacks[i],
+				K_THREAD_STACK_SIZEOF(hammer_stacks[i]), hammer_reports,
+				UINT_TO_POINTER(i), NULL, NULL, K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	}
+
+	for (int i = 0; i < HAMMER_THREADS; i++) {
+		k_thread_join(&hammer_threads[i], K_FOREVER);
+	}
+
+	/* Let the button work queue publish the events still queued. */
+	k_msleep(10);
+
+	zassert_true(atomic_get(&max_in_core) >= 2, "reports never overlapped");
+	check_invariants();
+}
+
+ZTEST(smp_stress, test_concurrent_repeats)
+{
+	struct button_cfg saved;
+	struct button_cfg cfg;
+
+	zassert_ok(button_cfg_get(0, &saved));
+	cfg = saved;
+	cfg.repeat_delay_ms = 1;
+	cfg.repeat_interval_ms = 1;
+	for (int i = 0; i < BUTTON_HOLD_LEVELS; i++) {
+		cfg.hold_ms[i] = 1 + i;
+	}
+	zassert_ok(button_cfg_set(BUTTON_CFG_ALL, &cfg));
+
+	for (int i = 0; i < HAMMER_THREADS; i++) {
+		k_thread_create(&hammer_threads[i], hammer_stacks[i],
+				K_THREAD_STACK_SIZEOF(hammer_stacks[i]), hammer_holds,
+				UINT_TO_POINTER(i), NULL, NULL, K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	}
+
+	for (int i = 0; i < HAMMER_THREADS; i++) {
+		k_thread_join(&hammer_threads[i], K_FOREVER);
+	}
+
+	/* Any handler run still under way must find its press over. */
+	k_msleep(10);
+	zassert_ok(button_cfg_set(BUTTON_CFG_ALL, &saved));
+
+	check_invariants();
+}
+
+ZTEST_SUITE(smp_stress, NULL, smp_stress_setup, NULL, NULL, NULL);